@@ -10,30 +10,59 @@ function(compile_shaders base_dir output_subdir shaders output_var)
         set(output_dir "${output_dir_pref}/${output_subdir}/")
     endif()
     set(gen_dir "${CMAKE_BINARY_DIR}/compiled_shaders/${output_subdir}/")
+    set(manifest "${CMAKE_BINARY_DIR}/compiled_shaders/${output_subdir}.manifest")
     unset(compiled_shaders)
+    unset(manifest_content)
     foreach(full_shader_path ${shaders})
         cmake_path(RELATIVE_PATH full_shader_path BASE_DIRECTORY "${base_dir}" OUTPUT_VARIABLE shader_name)
         get_filename_component(shader_folder ${shader_name} DIRECTORY)
         set(spirv ${gen_dir}/${shader_name}.spirv)
         set(dxil ${gen_dir}/${shader_name}.dxil)
+        set(spirv_reflection ${spirv}.refl)
+        set(dxil_reflection ${dxil}.refl)
         get_property(entrypoint SOURCE ${full_shader_path} PROPERTY SHADER_ENTRYPOINT)
         get_property(type SOURCE ${full_shader_path} PROPERTY SHADER_TYPE)
         get_property(model SOURCE ${full_shader_path} PROPERTY SHADER_MODEL)
-        add_custom_command(OUTPUT ${spirv} ${dxil}
-            COMMAND ${CMAKE_COMMAND} -E echo ${shader_name} ${full_shader_path} ${entrypoint} ${type} ${model} ${gen_dir}
-            COMMAND ${CMAKE_COMMAND} -E make_directory ${gen_dir}/${shader_folder}
-            COMMAND $<TARGET_FILE:ShaderCompilerCLI> ${shader_name} ${full_shader_path} ${entrypoint} ${type} ${model} ${gen_dir}
-            COMMAND ${CMAKE_COMMAND} -E copy_directory_if_different ${gen_dir}/${shader_folder} ${output_dir}/${shader_folder}
-            DEPENDS ShaderCompilerCLI
-            MAIN_DEPENDENCY "${full_shader_path}"
-        )
-        set_source_files_properties(${spirv} ${dxil} PROPERTIES
+        get_property(defines SOURCE ${full_shader_path} PROPERTY SHADER_DEFINES)
+        get_property(options SOURCE ${full_shader_path} PROPERTY SHADER_COMPILE_OPTIONS)
+        string(APPEND manifest_content "\"${shader_name}\" \"${full_shader_path}\" \"${entrypoint}\" ${type} ${model}")
+        foreach(define ${defines})
+            string(APPEND manifest_content " \"${define}\"")
+        endforeach()
+        foreach(option ${options})
+            string(APPEND manifest_content " \"${option}\"")
+        endforeach()
+        string(APPEND manifest_content "\n")
+        set_source_files_properties(${spirv} ${dxil} ${spirv_reflection} ${dxil_reflection} PROPERTIES
             MACOSX_PACKAGE_LOCATION "Resources/${output_subdir}/${shader_folder}"
         )
         source_group("Shader Files" FILES "${full_shader_path}")
-        source_group("Shader Blobs" FILES ${spirv} ${dxil})
-        set(compiled_shaders ${compiled_shaders} ${spirv})
-        set(compiled_shaders ${compiled_shaders} ${dxil})
+        source_group("Shader Blobs" FILES ${spirv} ${dxil} ${spirv_reflection} ${dxil_reflection})
+        set(compiled_shaders ${compiled_shaders} ${spirv} ${spirv_reflection})
+        set(compiled_shaders ${compiled_shaders} ${dxil} ${dxil_reflection})
+        if (METAL_SUPPORT AND NOT type STREQUAL "Library")
+            set(msl ${gen_dir}/${shader_name}.msl)
+            set_source_files_properties(${msl} PROPERTIES
+                MACOSX_PACKAGE_LOCATION "Resources/${output_subdir}/${shader_folder}"
+            )
+            source_group("Shader Blobs" FILES ${msl})
+            set(compiled_shaders ${compiled_shaders} ${msl})
+        endif()
     endforeach()
+    set(archive ${gen_dir}/shaders.fcsa)
+    set_source_files_properties(${archive} PROPERTIES
+        MACOSX_PACKAGE_LOCATION "Resources/${output_subdir}"
+    )
+    source_group("Shader Blobs" FILES ${archive})
+    set(compiled_shaders ${compiled_shaders} ${archive})
+    # Only rewritten when the content changes, so reconfiguring does not recompile every shader
+    file(CONFIGURE OUTPUT ${manifest} CONTENT "${manifest_content}" @ONLY)
+    add_custom_command(OUTPUT ${compiled_shaders}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${gen_dir}
+        COMMAND $<TARGET_FILE:ShaderCompilerCLI> --manifest ${manifest} ${gen_dir} ${manifest}.d $<$<BOOL:${METAL_SUPPORT}>:--msl>
+        COMMAND ${CMAKE_COMMAND} -E copy_directory_if_different ${gen_dir} ${output_dir}
+        DEPENDS ShaderCompilerCLI ${manifest} ${shaders}
+        DEPFILE ${manifest}.d
+    )
     set(${output_var} ${compiled_shaders} PARENT_SCOPE)
 endfunction()
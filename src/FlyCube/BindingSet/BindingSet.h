@@ -2,11 +2,24 @@
 #include "Instance/BaseTypes.h"
 #include "Instance/QueryInterface.h"
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 
+struct ResolvedBindingDesc {
+    BindKey bind_key;
+    // Returned by BindingSet::ResolveBinding for bind_key
+    uint64_t location;
+    std::shared_ptr<View> view;
+};
+
 class BindingSet : public QueryInterface {
 public:
     virtual ~BindingSet() = default;
+    // Bindings that are not listed keep the views written before
     virtual void WriteBindings(const std::vector<BindingDesc>& bindings) = 0;
+    // Backend location of a bind key of the layout, e.g. the descriptor heap offset, resolved once by the caller
+    virtual uint64_t ResolveBinding(const BindKey& bind_key) const = 0;
+    // Same as WriteBindings without the per bind key lookups
+    virtual void WriteResolvedBindings(const std::vector<ResolvedBindingDesc>& bindings) = 0;
 };
@@ -11,26 +11,42 @@ DXBindingSet::DXBindingSet(DXDevice& device, const std::shared_ptr<DXBindingSetL
     , m_layout(layout)
 {
     for (const auto& desc : m_layout->GetHeapDescs()) {
-        std::shared_ptr<DXGPUDescriptorPoolRange> heap_range = std::make_shared<DXGPUDescriptorPoolRange>(
+        m_descriptor_ranges[desc.first] = std::make_shared<DXGPUDescriptorPoolRange>(
             m_device.GetGPUDescriptorPool().Allocate(desc.first, desc.second));
-        m_descriptor_ranges.emplace(std::piecewise_construct, std::forward_as_tuple(desc.first),
-                                    std::forward_as_tuple(heap_range));
     }
 }
 
 void DXBindingSet::WriteBindings(const std::vector<BindingDesc>& bindings)
 {
     for (const auto& binding : bindings) {
-        if (!binding.view) {
-            continue;
+        if (binding.view) {
+            WriteBinding(ResolveBinding(binding.bind_key), binding.view);
         }
-        decltype(auto) binding_layout = m_layout->GetLayout().at(binding.bind_key);
-        std::shared_ptr<DXGPUDescriptorPoolRange> heap_range = m_descriptor_ranges.at(binding_layout.heap_type);
-        decltype(auto) src_cpu_handle = binding.view->As<DXView>().GetHandle();
-        heap_range->CopyCpuHandle(binding_layout.heap_offset, src_cpu_handle);
     }
 }
 
+uint64_t DXBindingSet::ResolveBinding(const BindKey& bind_key) const
+{
+    decltype(auto) binding_layout = m_layout->GetLayout().at(bind_key);
+    return (static_cast<uint64_t>(binding_layout.heap_type) << 32) | binding_layout.heap_offset;
+}
+
+void DXBindingSet::WriteResolvedBindings(const std::vector<ResolvedBindingDesc>& bindings)
+{
+    for (const auto& binding : bindings) {
+        if (binding.view) {
+            WriteBinding(binding.location, binding.view);
+        }
+    }
+}
+
+void DXBindingSet::WriteBinding(uint64_t location, const std::shared_ptr<View>& view)
+{
+    decltype(auto) heap_range = m_descriptor_ranges[location >> 32];
+    assert(heap_range);
+    heap_range->CopyCpuHandle(static_cast<uint32_t>(location), view->As<DXView>().GetHandle());
+}
+
 void SetRootDescriptorTable(const ComPtr<ID3D12GraphicsCommandList>& command_list,
                             uint32_t root_parameter,
                             bool is_compute,
@@ -52,7 +68,7 @@ std::vector<ComPtr<ID3D12DescriptorHeap>> DXBindingSet::Apply(const ComPtr<ID3D1
         if (table.second.bindless) {
             heap = m_device.GetGPUDescriptorPool().GetHeap(heap_type);
         } else {
-            heap = m_descriptor_ranges.at(heap_type)->GetHeap();
+            heap = m_descriptor_ranges[heap_type]->GetHeap();
         }
 
         auto it = heap_map.find(heap_type);
@@ -79,7 +95,7 @@ std::vector<ComPtr<ID3D12DescriptorHeap>> DXBindingSet::Apply(const ComPtr<ID3D1
         if (table.second.bindless) {
             base_descriptor = m_device.GetGPUDescriptorPool().GetHeap(heap_type)->GetGPUDescriptorHandleForHeapStart();
         } else {
-            decltype(auto) heap_range = m_descriptor_ranges.at(heap_type);
+            decltype(auto) heap_range = m_descriptor_ranges[heap_type];
             base_descriptor = heap_range->GetGpuHandle(table.second.heap_offset);
         }
         SetRootDescriptorTable(command_list, table.first, table.second.is_compute, base_descriptor);
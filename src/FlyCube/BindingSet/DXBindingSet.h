@@ -4,6 +4,8 @@
 
 #include <directx/d3d12.h>
 #include <wrl.h>
+
+#include <array>
 using namespace Microsoft::WRL;
 
 class DXDevice;
@@ -15,11 +17,16 @@ public:
     DXBindingSet(DXDevice& device, const std::shared_ptr<DXBindingSetLayout>& layout);
 
     void WriteBindings(const std::vector<BindingDesc>& bindings) override;
+    uint64_t ResolveBinding(const BindKey& bind_key) const override;
+    void WriteResolvedBindings(const std::vector<ResolvedBindingDesc>& bindings) override;
 
     std::vector<ComPtr<ID3D12DescriptorHeap>> Apply(const ComPtr<ID3D12GraphicsCommandList>& command_list);
 
 private:
+    void WriteBinding(uint64_t location, const std::shared_ptr<View>& view);
+
     DXDevice& m_device;
     std::shared_ptr<DXBindingSetLayout> m_layout;
-    std::map<D3D12_DESCRIPTOR_HEAP_TYPE, std::shared_ptr<DXGPUDescriptorPoolRange>> m_descriptor_ranges;
+    // Indexed by heap type, so that writes don't search for the range
+    std::array<std::shared_ptr<DXGPUDescriptorPoolRange>, D3D12_DESCRIPTOR_HEAP_TYPE_NUM_TYPES> m_descriptor_ranges;
 };
@@ -5,6 +5,7 @@
 
 class MTDevice;
 class MTBindingSetLayout;
+class MTView;
 class Pipeline;
 
 class MTBindingSet : public BindingSet {
@@ -12,11 +13,19 @@ public:
     MTBindingSet(MTDevice& device, const std::shared_ptr<MTBindingSetLayout>& layout);
 
     void WriteBindings(const std::vector<BindingDesc>& bindings) override;
+    uint64_t ResolveBinding(const BindKey& bind_key) const override;
+    void WriteResolvedBindings(const std::vector<ResolvedBindingDesc>& bindings) override;
 
     void Apply(id<MTLRenderCommandEncoder> render_encoder, const std::shared_ptr<Pipeline>& state);
     void Apply(id<MTLComputeCommandEncoder> compute_encoder, const std::shared_ptr<Pipeline>& state);
 
 private:
+    void WriteBinding(const BindKey& bind_key, const std::shared_ptr<View>& new_view);
+    std::vector<id<MTLResource>>& GetUsedResources(ShaderType shader_type, MTLResourceUsage usage);
+    void WriteArgument(const BindKey& bind_key,
+                       const std::shared_ptr<MTView>& prev_view,
+                       const std::shared_ptr<MTView>& view);
+
     MTDevice& m_device;
     std::shared_ptr<MTBindingSetLayout> m_layout;
     std::map<std::pair<ShaderType, uint32_t>, id<MTLBuffer>> m_argument_buffers;
@@ -24,5 +33,6 @@ private:
     std::map<MTLResourceUsage, std::vector<id<MTLResource>>> m_compure_resouces;
     std::map<std::pair<MTLRenderStages, MTLResourceUsage>, std::vector<id<MTLResource>>> m_graphics_resouces;
     std::vector<BindKey> m_direct_bind_keys;
-    std::vector<BindingDesc> m_direct_bindings;
+    std::map<BindKey, std::shared_ptr<View>> m_direct_bindings;
+    std::map<BindKey, std::shared_ptr<View>> m_bindings;
 };
@@ -7,6 +7,9 @@
 #include "Shader/MTShader.h"
 #include "View/MTView.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace {
 
 MTLRenderStages GetStage(ShaderType type)
@@ -149,15 +152,11 @@ void ValidateRemappedSlots(const std::shared_ptr<Pipeline>& state, const std::ve
 template <typename CommandEncoderType>
 void ApplyDirectArguments(CommandEncoderType encoder,
                           const std::vector<BindKey>& bind_keys,
-                          const std::vector<BindingDesc>& bindings,
+                          const std::map<BindKey, std::shared_ptr<View>>& bindings,
                           MTDevice& device)
 {
-    for (const auto& binding : bindings) {
-        const BindKey& bind_key = binding.bind_key;
-        if (bind_key.count == ~0) {
-            continue;
-        }
-        decltype(auto) mt_view = std::static_pointer_cast<MTView>(binding.view);
+    for (const auto& [bind_key, view] : bindings) {
+        decltype(auto) mt_view = std::static_pointer_cast<MTView>(view);
         uint32_t index = bind_key.GetRemappedSlot();
         SetView(bind_key.shader_type, encoder, mt_view, index);
     }
@@ -220,45 +219,73 @@ MTBindingSet::MTBindingSet(MTDevice& device, const std::shared_ptr<MTBindingSetL
 
 void MTBindingSet::WriteBindings(const std::vector<BindingDesc>& bindings)
 {
-    if (!UseArgumentBuffers()) {
-        m_direct_bindings = bindings;
-        return;
+    for (const auto& binding : bindings) {
+        WriteBinding(binding.bind_key, binding.view);
     }
+}
 
-    m_direct_bindings.clear();
-    m_compure_resouces.clear();
-    m_graphics_resouces.clear();
+uint64_t MTBindingSet::ResolveBinding(const BindKey& bind_key) const
+{
+    // Bindings are kept by bind key, there is nothing to resolve
+    return 0;
+}
 
+void MTBindingSet::WriteResolvedBindings(const std::vector<ResolvedBindingDesc>& bindings)
+{
     for (const auto& binding : bindings) {
-        decltype(auto) bind_key = binding.bind_key;
-        if (bind_key.space >= spirv_cross::kMaxArgumentBuffers) {
-            if (bind_key.count != ~0) {
-                m_direct_bindings.push_back(binding);
-            }
-            continue;
-        }
-        decltype(auto) view = std::static_pointer_cast<MTView>(binding.view);
-        assert(view->GetViewDesc().view_type == bind_key.view_type);
+        WriteBinding(binding.bind_key, binding.view);
+    }
+}
 
-        uint32_t index = bind_key.GetRemappedSlot();
-        uint32_t slots = m_slots_count[{ bind_key.shader_type, bind_key.space }];
-        assert(index < slots);
-        uint64_t* arguments =
-            static_cast<uint64_t*>(m_argument_buffers[{ bind_key.shader_type, bind_key.space }].contents);
-        arguments[index] = view->GetGpuAddress();
+void MTBindingSet::WriteBinding(const BindKey& bind_key, const std::shared_ptr<View>& new_view)
+{
+    // Only the written key is updated, the rest of the set is left untouched
+    std::shared_ptr<View>& view = m_bindings[bind_key];
+    if (view == new_view) {
+        return;
+    }
+    std::shared_ptr<View> prev_view = std::exchange(view, new_view);
 
-        id<MTLResource> resource = view->GetNativeResource();
-        if (!resource) {
-            continue;
+    if (!UseArgumentBuffers() || bind_key.space >= spirv_cross::kMaxArgumentBuffers) {
+        if (bind_key.count != ~0) {
+            m_direct_bindings[bind_key] = new_view;
         }
+        return;
+    }
+    WriteArgument(bind_key, std::static_pointer_cast<MTView>(prev_view), std::static_pointer_cast<MTView>(new_view));
+}
 
-        MTLResourceUsage usage = view->GetUsage();
-        if (bind_key.shader_type == ShaderType::kCompute) {
-            m_compure_resouces[usage].push_back(resource);
-        } else {
-            m_graphics_resouces[{ GetStage(bind_key.shader_type), usage }].push_back(resource);
+std::vector<id<MTLResource>>& MTBindingSet::GetUsedResources(ShaderType shader_type, MTLResourceUsage usage)
+{
+    if (shader_type == ShaderType::kCompute) {
+        return m_compure_resouces[usage];
+    }
+    return m_graphics_resouces[{ GetStage(shader_type), usage }];
+}
+
+void MTBindingSet::WriteArgument(const BindKey& bind_key,
+                                 const std::shared_ptr<MTView>& prev_view,
+                                 const std::shared_ptr<MTView>& view)
+{
+    assert(view->GetViewDesc().view_type == bind_key.view_type);
+    uint32_t index = bind_key.GetRemappedSlot();
+    uint32_t slots = m_slots_count[{ bind_key.shader_type, bind_key.space }];
+    assert(index < slots);
+    uint64_t* arguments = static_cast<uint64_t*>(m_argument_buffers[{ bind_key.shader_type, bind_key.space }].contents);
+    arguments[index] = view->GetGpuAddress();
+
+    if (prev_view && prev_view->GetNativeResource()) {
+        // The same resource may be used by several keys, so only one occurrence is removed
+        decltype(auto) resources = GetUsedResources(bind_key.shader_type, prev_view->GetUsage());
+        auto it = std::find(resources.begin(), resources.end(), prev_view->GetNativeResource());
+        if (it != resources.end()) {
+            *it = resources.back();
+            resources.pop_back();
         }
     }
+    if (id<MTLResource> resource = view->GetNativeResource()) {
+        GetUsedResources(bind_key.shader_type, view->GetUsage()).push_back(resource);
+    }
 }
 
 void MTBindingSet::Apply(id<MTLRenderCommandEncoder> render_encoder, const std::shared_ptr<Pipeline>& state)
@@ -0,0 +1,91 @@
+#include "BindingSet/ParameterBlock.h"
+
+#include <cassert>
+
+ParameterBlock::ParameterBlock(const std::shared_ptr<Program>& program, const std::shared_ptr<BindingSet>& binding_set)
+    : m_binding_set(binding_set)
+{
+    std::map<std::string, std::vector<BindKey>> bind_keys_by_name;
+    for (const auto& shader : program->GetShaders()) {
+        for (const auto& binding : shader->GetResourceBindings()) {
+            if (binding.is_root_constant) {
+                continue;
+            }
+            bind_keys_by_name[binding.name].emplace_back(shader->GetBindKey(binding.name));
+        }
+    }
+
+    for (const auto& [name, bind_keys] : bind_keys_by_name) {
+        m_slots.emplace(name, m_bind_key_offsets.size());
+        m_bind_key_offsets.emplace_back(m_bind_keys.size());
+        m_bind_keys.insert(m_bind_keys.end(), bind_keys.begin(), bind_keys.end());
+    }
+    m_bind_key_offsets.emplace_back(m_bind_keys.size());
+
+    m_bind_key_locations.reserve(m_bind_keys.size());
+    for (const auto& bind_key : m_bind_keys) {
+        m_bind_key_locations.emplace_back(m_binding_set->ResolveBinding(bind_key));
+    }
+
+    m_views.resize(m_slots.size());
+    m_is_dirty.resize(m_slots.size());
+    m_dirty_slots.reserve(m_slots.size());
+    m_pending_bindings.reserve(m_bind_keys.size());
+}
+
+uint32_t ParameterBlock::GetSlot(const std::string& name) const
+{
+    auto it = m_slots.find(name);
+    if (it == m_slots.end()) {
+        return kInvalidSlot;
+    }
+    return it->second;
+}
+
+uint32_t ParameterBlock::GetSlotCount() const
+{
+    return m_views.size();
+}
+
+void ParameterBlock::SetView(uint32_t slot, const std::shared_ptr<View>& view)
+{
+    assert(slot < m_views.size());
+    if (m_views[slot] == view) {
+        return;
+    }
+    m_views[slot] = view;
+    if (!m_is_dirty[slot]) {
+        m_is_dirty[slot] = true;
+        m_dirty_slots.emplace_back(slot);
+    }
+}
+
+const std::shared_ptr<View>& ParameterBlock::GetView(uint32_t slot) const
+{
+    assert(slot < m_views.size());
+    return m_views[slot];
+}
+
+void ParameterBlock::Flush()
+{
+    for (uint32_t slot : m_dirty_slots) {
+        m_is_dirty[slot] = false;
+        if (!m_views[slot]) {
+            continue;
+        }
+        for (uint32_t i = m_bind_key_offsets[slot]; i < m_bind_key_offsets[slot + 1]; ++i) {
+            m_pending_bindings.push_back({ m_bind_keys[i], m_bind_key_locations[i], m_views[slot] });
+        }
+    }
+    m_dirty_slots.clear();
+
+    if (!m_pending_bindings.empty()) {
+        m_binding_set->WriteResolvedBindings(m_pending_bindings);
+        m_pending_bindings.clear();
+    }
+}
+
+const std::shared_ptr<BindingSet>& ParameterBlock::GetBindingSet() const
+{
+    return m_binding_set;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "BindingSet/BindingSet.h"
+#include "Program/Program.h"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Views of the program resources addressed by dense slots, names are resolved to slots once.
+// A resource declared by several shaders of the program shares one slot.
+// Flush writes only the slots changed since the previous flush, without allocations in the steady state.
+class ParameterBlock {
+public:
+    static constexpr uint32_t kInvalidSlot = ~0u;
+
+    ParameterBlock(const std::shared_ptr<Program>& program, const std::shared_ptr<BindingSet>& binding_set);
+
+    // Returns kInvalidSlot if no shader of the program declares a resource with this name
+    uint32_t GetSlot(const std::string& name) const;
+    uint32_t GetSlotCount() const;
+    void SetView(uint32_t slot, const std::shared_ptr<View>& view);
+    const std::shared_ptr<View>& GetView(uint32_t slot) const;
+    // Writes the views of the dirty slots with a single BindingSet::WriteResolvedBindings call
+    void Flush();
+    const std::shared_ptr<BindingSet>& GetBindingSet() const;
+
+private:
+    std::shared_ptr<BindingSet> m_binding_set;
+    std::map<std::string, uint32_t> m_slots;
+    // Bind keys of slot i are m_bind_keys[m_bind_key_offsets[i]] .. m_bind_keys[m_bind_key_offsets[i + 1] - 1]
+    std::vector<BindKey> m_bind_keys;
+    // BindingSet::ResolveBinding of each of m_bind_keys
+    std::vector<uint64_t> m_bind_key_locations;
+    std::vector<uint32_t> m_bind_key_offsets;
+    std::vector<std::shared_ptr<View>> m_views;
+    std::vector<bool> m_is_dirty;
+    std::vector<uint32_t> m_dirty_slots;
+    std::vector<ResolvedBindingDesc> m_pending_bindings;
+};
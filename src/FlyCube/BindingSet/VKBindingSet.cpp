@@ -25,22 +25,43 @@ VKBindingSet::VKBindingSet(VKDevice& device, const std::shared_ptr<VKBindingSetL
 
 void VKBindingSet::WriteBindings(const std::vector<BindingDesc>& bindings)
 {
-    std::vector<vk::WriteDescriptorSet> descriptors;
     for (const auto& binding : bindings) {
-        decltype(auto) vk_view = binding.view->As<VKView>();
-        vk::WriteDescriptorSet descriptor = vk_view.GetDescriptor();
-        descriptor.descriptorType = GetDescriptorType(binding.bind_key.view_type);
-        descriptor.dstSet = m_descriptor_sets[binding.bind_key.space];
-        descriptor.dstBinding = binding.bind_key.slot;
-        descriptor.dstArrayElement = 0;
-        descriptor.descriptorCount = 1;
-        if (descriptor.pImageInfo || descriptor.pBufferInfo || descriptor.pTexelBufferView || descriptor.pNext) {
-            descriptors.emplace_back(descriptor);
-        }
+        AddDescriptorWrite(binding.bind_key, ResolveBinding(binding.bind_key), binding.view);
     }
+    FlushDescriptorWrites();
+}
+
+uint64_t VKBindingSet::ResolveBinding(const BindKey& bind_key) const
+{
+    return (static_cast<uint64_t>(bind_key.space) << 32) | bind_key.slot;
+}
 
-    if (!descriptors.empty()) {
-        m_device.GetDevice().updateDescriptorSets(descriptors.size(), descriptors.data(), 0, nullptr);
+void VKBindingSet::WriteResolvedBindings(const std::vector<ResolvedBindingDesc>& bindings)
+{
+    for (const auto& binding : bindings) {
+        AddDescriptorWrite(binding.bind_key, binding.location, binding.view);
+    }
+    FlushDescriptorWrites();
+}
+
+void VKBindingSet::AddDescriptorWrite(const BindKey& bind_key, uint64_t location, const std::shared_ptr<View>& view)
+{
+    vk::WriteDescriptorSet descriptor = view->As<VKView>().GetDescriptor();
+    descriptor.descriptorType = GetDescriptorType(bind_key.view_type);
+    descriptor.dstSet = m_descriptor_sets[location >> 32];
+    descriptor.dstBinding = static_cast<uint32_t>(location);
+    descriptor.dstArrayElement = 0;
+    descriptor.descriptorCount = 1;
+    if (descriptor.pImageInfo || descriptor.pBufferInfo || descriptor.pTexelBufferView || descriptor.pNext) {
+        m_descriptor_writes.emplace_back(descriptor);
+    }
+}
+
+void VKBindingSet::FlushDescriptorWrites()
+{
+    if (!m_descriptor_writes.empty()) {
+        m_device.GetDevice().updateDescriptorSets(m_descriptor_writes.size(), m_descriptor_writes.data(), 0, nullptr);
+        m_descriptor_writes.clear();
     }
 }
 
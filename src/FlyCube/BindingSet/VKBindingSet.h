@@ -12,11 +12,18 @@ public:
     VKBindingSet(VKDevice& device, const std::shared_ptr<VKBindingSetLayout>& layout);
 
     void WriteBindings(const std::vector<BindingDesc>& bindings) override;
+    uint64_t ResolveBinding(const BindKey& bind_key) const override;
+    void WriteResolvedBindings(const std::vector<ResolvedBindingDesc>& bindings) override;
     const std::vector<vk::DescriptorSet>& GetDescriptorSets() const;
 
 private:
+    void AddDescriptorWrite(const BindKey& bind_key, uint64_t location, const std::shared_ptr<View>& view);
+    void FlushDescriptorWrites();
+
     VKDevice& m_device;
     std::vector<DescriptorSetPool> m_descriptors;
     std::vector<vk::DescriptorSet> m_descriptor_sets;
     std::shared_ptr<VKBindingSetLayout> m_layout;
+    // Reused by every write, so that steady state writes don't allocate
+    std::vector<vk::WriteDescriptorSet> m_descriptor_writes;
 };
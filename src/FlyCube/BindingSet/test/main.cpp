@@ -0,0 +1,149 @@
+#include "BindingSet/BindingSet.h"
+#include "BindingSet/ParameterBlock.h"
+#include "Program/ProgramBase.h"
+#include "Shader/ShaderBase.h"
+#include "View/View.h"
+
+#include <catch2/catch_all.hpp>
+
+#include <memory>
+#include <vector>
+
+class TestView : public View {
+public:
+    std::shared_ptr<Resource> GetResource() override
+    {
+        return nullptr;
+    }
+
+    uint32_t GetDescriptorId() const override
+    {
+        return 0;
+    }
+
+    uint32_t GetBaseMipLevel() const override
+    {
+        return 0;
+    }
+
+    uint32_t GetLevelCount() const override
+    {
+        return 1;
+    }
+
+    uint32_t GetBaseArrayLayer() const override
+    {
+        return 0;
+    }
+
+    uint32_t GetLayerCount() const override
+    {
+        return 1;
+    }
+};
+
+class TestBindingSet : public BindingSet {
+public:
+    void WriteBindings(const std::vector<BindingDesc>& bindings) override
+    {
+        for (const auto& binding : bindings) {
+            writes.push_back({ binding.bind_key, ResolveBinding(binding.bind_key), binding.view });
+        }
+    }
+
+    uint64_t ResolveBinding(const BindKey& bind_key) const override
+    {
+        return (static_cast<uint64_t>(bind_key.shader_type) << 32) | bind_key.slot;
+    }
+
+    void WriteResolvedBindings(const std::vector<ResolvedBindingDesc>& bindings) override
+    {
+        ++write_count;
+        writes.insert(writes.end(), bindings.begin(), bindings.end());
+    }
+
+    uint32_t write_count = 0;
+    std::vector<ResolvedBindingDesc> writes;
+};
+
+std::shared_ptr<Program> CreateTestProgram()
+{
+    ShaderDesc vertex_desc = { "memory/ParameterBlockVS.hlsl", "main", ShaderType::kVertex, "6_3" };
+    vertex_desc.source = "cbuffer Settings : register(b0) { float4 color; };\n"
+                         "float4 main(float4 pos : POSITION) : SV_POSITION { return pos * color; }";
+    ShaderDesc pixel_desc = { "memory/ParameterBlockPS.hlsl", "main", ShaderType::kPixel, "6_3" };
+    pixel_desc.source = "cbuffer Settings : register(b0) { float4 color; };\n"
+                        "Texture2D tex : register(t0);\n"
+                        "SamplerState tex_sampler : register(s0);\n"
+                        "float4 main(float4 pos : SV_POSITION) : SV_TARGET\n"
+                        "{\n"
+                        "    return color * tex.Sample(tex_sampler, pos.xy);\n"
+                        "}";
+    return std::make_shared<ProgramBase>(std::vector<std::shared_ptr<Shader>>{
+        std::make_shared<ShaderBase>(vertex_desc, ShaderBlobType::kSPIRV),
+        std::make_shared<ShaderBase>(pixel_desc, ShaderBlobType::kSPIRV),
+    });
+}
+
+TEST_CASE("ParameterBlockSlots")
+{
+    auto binding_set = std::make_shared<TestBindingSet>();
+    ParameterBlock parameter_block(CreateTestProgram(), binding_set);
+    REQUIRE(parameter_block.GetSlotCount() == 3);
+    REQUIRE(parameter_block.GetSlot("Missing") == ParameterBlock::kInvalidSlot);
+
+    uint32_t settings_slot = parameter_block.GetSlot("Settings");
+    REQUIRE(settings_slot != ParameterBlock::kInvalidSlot);
+    auto settings = std::make_shared<TestView>();
+    parameter_block.SetView(settings_slot, settings);
+    parameter_block.Flush();
+
+    // Declared by both shaders, so one slot writes both bind keys with the locations resolved up front
+    REQUIRE(binding_set->write_count == 1);
+    REQUIRE(binding_set->writes.size() == 2);
+    REQUIRE(binding_set->writes[0].bind_key.shader_type != binding_set->writes[1].bind_key.shader_type);
+    for (const auto& write : binding_set->writes) {
+        REQUIRE(write.view == settings);
+        REQUIRE(write.location == binding_set->ResolveBinding(write.bind_key));
+    }
+}
+
+TEST_CASE("ParameterBlockDirtyTracking")
+{
+    auto binding_set = std::make_shared<TestBindingSet>();
+    ParameterBlock parameter_block(CreateTestProgram(), binding_set);
+    uint32_t texture_slot = parameter_block.GetSlot("tex");
+    uint32_t sampler_slot = parameter_block.GetSlot("tex_sampler");
+    REQUIRE(texture_slot != ParameterBlock::kInvalidSlot);
+    REQUIRE(sampler_slot != ParameterBlock::kInvalidSlot);
+
+    auto texture = std::make_shared<TestView>();
+    auto sampler = std::make_shared<TestView>();
+    parameter_block.SetView(texture_slot, texture);
+    parameter_block.SetView(sampler_slot, sampler);
+    parameter_block.Flush();
+    REQUIRE(binding_set->write_count == 1);
+    REQUIRE(binding_set->writes.size() == 2);
+
+    // Nothing changed since the previous flush
+    parameter_block.Flush();
+    REQUIRE(binding_set->write_count == 1);
+
+    // Setting the view already bound doesn't dirty the slot
+    parameter_block.SetView(texture_slot, texture);
+    parameter_block.Flush();
+    REQUIRE(binding_set->write_count == 1);
+
+    // Only the last view set between flushes is written, once
+    binding_set->writes.clear();
+    auto other_texture = std::make_shared<TestView>();
+    parameter_block.SetView(texture_slot, other_texture);
+    parameter_block.SetView(texture_slot, std::make_shared<TestView>());
+    parameter_block.SetView(texture_slot, other_texture);
+    parameter_block.Flush();
+    REQUIRE(binding_set->write_count == 2);
+    REQUIRE(binding_set->writes.size() == 1);
+    REQUIRE(binding_set->writes[0].view == other_texture);
+    REQUIRE(parameter_block.GetView(texture_slot) == other_texture);
+    REQUIRE(parameter_block.GetView(sampler_slot) == sampler);
+}
@@ -102,7 +102,9 @@ DXBindingSetLayout::DXBindingSetLayout(DXDevice& device, const std::vector<BindK
         root_constant_param.Constants.ShaderRegister = shader_register;
         root_constant_param.Constants.RegisterSpace = register_space;
         root_constant_param.ShaderVisibility = GetVisibility(shader_type);
+        size_t root_param_index = root_parameters.size();
         root_parameters.push_back(root_constant_param);
+        return root_param_index;
     };
 
     auto add_bindless_range = [&](ShaderType shader_type, ViewType view_type, uint32_t base_slot, uint32_t space) {
@@ -130,7 +132,8 @@ DXBindingSetLayout::DXBindingSetLayout(DXDevice& device, const std::vector<BindK
         }
 
         if (bind_key.is_root_constant) {
-            add_root_constant(bind_key.slot, bind_key.space, bind_key.count, bind_key.shader_type);
+            m_root_constants[bind_key] =
+                add_root_constant(bind_key.slot, bind_key.space, bind_key.count, bind_key.shader_type);
             continue;
         }
 
@@ -198,6 +201,11 @@ const std::map<uint32_t, DescriptorTableDesc>& DXBindingSetLayout::GetDescriptor
     return m_descriptor_tables;
 }
 
+const std::map<BindKey, uint32_t>& DXBindingSetLayout::GetRootConstants() const
+{
+    return m_root_constants;
+}
+
 const ComPtr<ID3D12RootSignature>& DXBindingSetLayout::GetRootSignature() const
 {
     return m_root_signature;
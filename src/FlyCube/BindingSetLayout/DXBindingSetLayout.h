@@ -27,6 +27,8 @@ public:
     const std::map<D3D12_DESCRIPTOR_HEAP_TYPE, size_t>& GetHeapDescs() const;
     const std::map<BindKey, BindingLayout>& GetLayout() const;
     const std::map<uint32_t, DescriptorTableDesc>& GetDescriptorTables() const;
+    // Root parameter index of each root constant
+    const std::map<BindKey, uint32_t>& GetRootConstants() const;
     const ComPtr<ID3D12RootSignature>& GetRootSignature() const;
 
 private:
@@ -34,5 +36,6 @@ private:
     std::map<D3D12_DESCRIPTOR_HEAP_TYPE, size_t> m_heap_descs;
     std::map<BindKey, BindingLayout> m_layout;
     std::map<uint32_t, DescriptorTableDesc> m_descriptor_tables;
+    std::map<BindKey, uint32_t> m_root_constants;
     ComPtr<ID3D12RootSignature> m_root_signature;
 };
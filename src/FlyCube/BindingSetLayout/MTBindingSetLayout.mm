@@ -2,10 +2,15 @@
 
 #include "Device/MTDevice.h"
 
+#include <algorithm>
+#include <iterator>
+
 MTBindingSetLayout::MTBindingSetLayout(MTDevice& device, const std::vector<BindKey>& descs)
     : m_device(device)
-    , m_descs(descs)
 {
+    // Root constants are not supported on Metal yet, they have no argument buffer slot
+    std::copy_if(descs.begin(), descs.end(), std::back_inserter(m_descs),
+                 [](const BindKey& bind_key) { return !bind_key.is_root_constant; });
 }
 
 const std::vector<BindKey>& MTBindingSetLayout::GetBindKeys() const
@@ -2,6 +2,8 @@
 
 #include "Device/VKDevice.h"
 
+#include <algorithm>
+
 vk::DescriptorType GetDescriptorType(ViewType view_type)
 {
     switch (view_type) {
@@ -58,7 +60,14 @@ VKBindingSetLayout::VKBindingSetLayout(VKDevice& device, const std::vector<BindK
     std::map<uint32_t, std::vector<vk::DescriptorSetLayoutBinding>> bindings_by_set;
     std::map<uint32_t, std::vector<vk::DescriptorBindingFlags>> bindings_flags_by_set;
 
+    uint32_t push_constant_size = 0;
     for (const auto& bind_key : descs) {
+        if (bind_key.is_root_constant) {
+            m_push_constant_stages |= ShaderType2Bit(bind_key.shader_type);
+            push_constant_size = std::max<uint32_t>(push_constant_size, bind_key.count * sizeof(uint32_t));
+            continue;
+        }
+
         decltype(auto) binding = bindings_by_set[bind_key.space].emplace_back();
         binding.binding = bind_key.slot;
         binding.descriptorType = GetDescriptorType(bind_key.view_type);
@@ -113,6 +122,14 @@ VKBindingSetLayout::VKBindingSetLayout(VKDevice& device, const std::vector<BindK
     pipeline_layout_info.setLayoutCount = descriptor_set_layouts.size();
     pipeline_layout_info.pSetLayouts = descriptor_set_layouts.data();
 
+    // Push constant blocks of all stages start at offset 0 and alias the same bytes, so one range covers them all.
+    // Separate ranges would repeat stages, e.g. several library shaders all map to eAll
+    vk::PushConstantRange push_constant_range(m_push_constant_stages, 0, push_constant_size);
+    if (push_constant_size > 0) {
+        pipeline_layout_info.pushConstantRangeCount = 1;
+        pipeline_layout_info.pPushConstantRanges = &push_constant_range;
+    }
+
     m_pipeline_layout = device.GetDevice().createPipelineLayoutUnique(pipeline_layout_info);
 }
 
@@ -131,6 +148,11 @@ const std::vector<std::map<vk::DescriptorType, size_t>>& VKBindingSetLayout::Get
     return m_descriptor_count_by_set;
 }
 
+vk::ShaderStageFlags VKBindingSetLayout::GetPushConstantStages() const
+{
+    return m_push_constant_stages;
+}
+
 vk::PipelineLayout VKBindingSetLayout::GetPipelineLayout() const
 {
     return m_pipeline_layout.get();
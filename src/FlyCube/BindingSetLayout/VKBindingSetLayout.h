@@ -12,12 +12,14 @@ public:
     const std::map<uint32_t, vk::DescriptorType>& GetBindlessType() const;
     const std::vector<vk::UniqueDescriptorSetLayout>& GetDescriptorSetLayouts() const;
     const std::vector<std::map<vk::DescriptorType, size_t>>& GetDescriptorCountBySet() const;
+    vk::ShaderStageFlags GetPushConstantStages() const;
     vk::PipelineLayout GetPipelineLayout() const;
 
 private:
     std::map<uint32_t, vk::DescriptorType> m_bindless_type;
     std::vector<vk::UniqueDescriptorSetLayout> m_descriptor_set_layouts;
     std::vector<std::map<vk::DescriptorType, size_t>> m_descriptor_count_by_set;
+    vk::ShaderStageFlags m_push_constant_stages;
     vk::UniquePipelineLayout m_pipeline_layout;
 };
 
@@ -0,0 +1,9 @@
+#include "CommandList/CommandList.h"
+
+#include <cassert>
+
+void CommandList::BindPendingPipeline(const std::shared_ptr<PendingPipeline>& state)
+{
+    assert(state->IsReady());
+    BindPipeline(state->Wait());
+}
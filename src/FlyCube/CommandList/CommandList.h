@@ -3,6 +3,7 @@
 #include "Framebuffer/Framebuffer.h"
 #include "Instance/BaseTypes.h"
 #include "Instance/QueryInterface.h"
+#include "Pipeline/PendingPipeline.h"
 #include "Pipeline/Pipeline.h"
 #include "QueryHeap/QueryHeap.h"
 #include "Resource/Resource.h"
@@ -19,7 +20,11 @@ public:
     virtual void Reset() = 0;
     virtual void Close() = 0;
     virtual void BindPipeline(const std::shared_ptr<Pipeline>& state) = 0;
+    // Only ready pipelines may be bound, check PendingPipeline::IsReady before recording
+    void BindPendingPipeline(const std::shared_ptr<PendingPipeline>& state);
     virtual void BindBindingSet(const std::shared_ptr<BindingSet>& binding_set) = 0;
+    // Updates the first size bytes of a root constant, the bound pipeline must be created with a layout containing it
+    virtual void SetRootConstants(const BindKey& bind_key, const void* data, uint32_t size) = 0;
     virtual void BeginRenderPass(const std::shared_ptr<RenderPass>& render_pass,
                                  const std::shared_ptr<Framebuffer>& framebuffer,
                                  const ClearDesc& clear_desc) = 0;
@@ -69,6 +74,15 @@ public:
     virtual void IASetIndexBuffer(const std::shared_ptr<Resource>& resource, gli::format format) = 0;
     virtual void IASetVertexBuffer(uint32_t slot, const std::shared_ptr<Resource>& resource) = 0;
     virtual void RSSetShadingRate(ShadingRate shading_rate, const std::array<ShadingRateCombiner, 2>& combiners) = 0;
+    // States of pipelines created with GraphicsPipelineDesc::dynamic_state, they persist across such pipelines.
+    // Until set, and after a pipeline with baked states was bound, the defaults of RasterizerDesc,
+    // DepthStencilDesc and kTriangleList are used. Setting the current value again records nothing
+    // Without Device::IsDynamicStateSupported they are no-ops, except the topology on D3D12 which is always dynamic
+    virtual void SetCullMode(CullMode cull_mode) = 0;
+    virtual void SetFillMode(FillMode fill_mode) = 0;
+    virtual void SetDepthBias(int32_t depth_bias) = 0;
+    virtual void SetDepthStencilState(const DepthStencilDesc& desc) = 0;
+    virtual void SetPrimitiveTopology(PrimitiveTopology topology) = 0;
     virtual void BuildBottomLevelAS(const std::shared_ptr<Resource>& src,
                                     const std::shared_ptr<Resource>& dst,
                                     const std::shared_ptr<Resource>& scratch,
@@ -99,6 +113,12 @@ public:
         const std::vector<std::shared_ptr<Resource>>& acceleration_structures,
         const std::shared_ptr<QueryHeap>& query_heap,
         uint32_t first_query) = 0;
+    // Must be recorded outside of a render pass before queries are written again, a no-op where not required
+    virtual void ResetQueryHeap(const std::shared_ptr<QueryHeap>& query_heap,
+                                uint32_t first_query,
+                                uint32_t query_count) = 0;
+    // Writes the GPU time after all previous commands complete, ticks are converted with Device::GetTimestampFrequency
+    virtual void WriteTimestamp(const std::shared_ptr<QueryHeap>& query_heap, uint32_t query) = 0;
     virtual void ResolveQueryData(const std::shared_ptr<QueryHeap>& query_heap,
                                   uint32_t first_query,
                                   uint32_t query_count,
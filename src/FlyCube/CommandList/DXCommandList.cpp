@@ -1,12 +1,14 @@
 #include "CommandList/DXCommandList.h"
 
 #include "BindingSet/DXBindingSet.h"
+#include "BindingSetLayout/DXBindingSetLayout.h"
 #include "Device/DXDevice.h"
 #include "Framebuffer/DXFramebuffer.h"
 #include "Pipeline/DXComputePipeline.h"
 #include "Pipeline/DXGraphicsPipeline.h"
 #include "Pipeline/DXRayTracingPipeline.h"
 #include "QueryHeap/DXRayTracingQueryHeap.h"
+#include "QueryHeap/DXTimestampQueryHeap.h"
 #include "RenderPass/DXRenderPass.h"
 #include "Resource/DXResource.h"
 #include "Utilities/DXUtility.h"
@@ -71,6 +73,7 @@ void DXCommandList::Reset()
     m_heaps.clear();
     m_state.reset();
     m_binding_set.reset();
+    m_primitive_topology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
     m_lazy_vertex.clear();
     m_shading_rate_image_view.reset();
 }
@@ -93,7 +96,7 @@ void DXCommandList::BindPipeline(const std::shared_ptr<Pipeline>& state)
     auto type = m_state->GetPipelineType();
     if (type == PipelineType::kGraphics) {
         decltype(auto) dx_state = state->As<DXGraphicsPipeline>();
-        m_command_list->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+        SetPrimitiveTopology(PrimitiveTopology::kTriangleList);
         m_command_list->SetGraphicsRootSignature(dx_state.GetRootSignature().Get());
         m_command_list->SetPipelineState(dx_state.GetPipeline().Get());
         for (const auto& x : dx_state.GetStrideMap()) {
@@ -124,6 +127,19 @@ void DXCommandList::BindBindingSet(const std::shared_ptr<BindingSet>& binding_se
     m_binding_set = binding_set;
 }
 
+void DXCommandList::SetRootConstants(const BindKey& bind_key, const void* data, uint32_t size)
+{
+    assert(bind_key.is_root_constant);
+    assert(size % sizeof(uint32_t) == 0 && size <= bind_key.count * sizeof(uint32_t));
+    decltype(auto) dx_layout = m_state->GetLayout()->As<DXBindingSetLayout>();
+    uint32_t root_param_index = dx_layout.GetRootConstants().at(bind_key);
+    if (m_state->GetPipelineType() == PipelineType::kGraphics) {
+        m_command_list->SetGraphicsRoot32BitConstants(root_param_index, size / sizeof(uint32_t), data, 0);
+    } else {
+        m_command_list->SetComputeRoot32BitConstants(root_param_index, size / sizeof(uint32_t), data, 0);
+    }
+}
+
 void DXCommandList::BeginRenderPass(const std::shared_ptr<RenderPass>& render_pass,
                                     const std::shared_ptr<Framebuffer>& framebuffer,
                                     const ClearDesc& clear_desc)
@@ -528,6 +544,40 @@ void DXCommandList::RSSetShadingRate(ShadingRate shading_rate, const std::array<
                                       reinterpret_cast<const D3D12_SHADING_RATE_COMBINER*>(combiners.data()));
 }
 
+// D3D12 bakes rasterizer and depth stencil states into the pipeline and DXDevice::IsDynamicStateSupported is false,
+// so these setters have nothing to record
+void DXCommandList::SetCullMode(CullMode cull_mode) {}
+
+void DXCommandList::SetFillMode(FillMode fill_mode) {}
+
+void DXCommandList::SetDepthBias(int32_t depth_bias) {}
+
+void DXCommandList::SetDepthStencilState(const DepthStencilDesc& desc) {}
+
+D3D_PRIMITIVE_TOPOLOGY Convert(PrimitiveTopology topology)
+{
+    switch (topology) {
+    case PrimitiveTopology::kTriangleList:
+        return D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+    case PrimitiveTopology::kTriangleStrip:
+        return D3D_PRIMITIVE_TOPOLOGY_TRIANGLESTRIP;
+    default:
+        assert(false);
+        return D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+    }
+}
+
+// Graphics pipelines are created with the triangle topology type, any topology of that type can be set on the fly
+void DXCommandList::SetPrimitiveTopology(PrimitiveTopology topology)
+{
+    D3D_PRIMITIVE_TOPOLOGY dx_topology = Convert(topology);
+    if (m_primitive_topology == dx_topology) {
+        return;
+    }
+    m_primitive_topology = dx_topology;
+    m_command_list->IASetPrimitiveTopology(dx_topology);
+}
+
 void DXCommandList::BuildAccelerationStructure(D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS& inputs,
                                                const std::shared_ptr<Resource>& src,
                                                const std::shared_ptr<Resource>& dst,
@@ -709,12 +759,36 @@ void DXCommandList::WriteAccelerationStructuresProperties(
                                                                       dx_acceleration_structures.data());
 }
 
+void DXCommandList::ResetQueryHeap(const std::shared_ptr<QueryHeap>& query_heap,
+                                   uint32_t first_query,
+                                   uint32_t query_count)
+{
+    // D3D12 queries don't need to be reset before reuse
+}
+
+void DXCommandList::WriteTimestamp(const std::shared_ptr<QueryHeap>& query_heap, uint32_t query)
+{
+    if (query_heap->GetType() != QueryHeapType::kTimestamp) {
+        assert(false);
+        return;
+    }
+    decltype(auto) dx_query_heap = query_heap->As<DXTimestampQueryHeap>();
+    m_command_list->EndQuery(dx_query_heap.GetQueryHeap().Get(), D3D12_QUERY_TYPE_TIMESTAMP, query);
+}
+
 void DXCommandList::ResolveQueryData(const std::shared_ptr<QueryHeap>& query_heap,
                                      uint32_t first_query,
                                      uint32_t query_count,
                                      const std::shared_ptr<Resource>& dst_buffer,
                                      uint64_t dst_offset)
 {
+    if (query_heap->GetType() == QueryHeapType::kTimestamp) {
+        decltype(auto) dx_query_heap = query_heap->As<DXTimestampQueryHeap>();
+        decltype(auto) dx_dst_buffer = dst_buffer->As<DXResource>();
+        m_command_list->ResolveQueryData(dx_query_heap.GetQueryHeap().Get(), D3D12_QUERY_TYPE_TIMESTAMP, first_query,
+                                         query_count, dx_dst_buffer.resource.Get(), dst_offset);
+        return;
+    }
     if (query_heap->GetType() != QueryHeapType::kAccelerationStructureCompactedSize) {
         assert(false);
         return;
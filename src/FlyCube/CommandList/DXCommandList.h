@@ -17,6 +17,7 @@ public:
     void Close() override;
     void BindPipeline(const std::shared_ptr<Pipeline>& state) override;
     void BindBindingSet(const std::shared_ptr<BindingSet>& binding_set) override;
+    void SetRootConstants(const BindKey& bind_key, const void* data, uint32_t size) override;
     void BeginRenderPass(const std::shared_ptr<RenderPass>& render_pass,
                          const std::shared_ptr<Framebuffer>& framebuffer,
                          const ClearDesc& clear_desc) override;
@@ -60,6 +61,11 @@ public:
     void IASetIndexBuffer(const std::shared_ptr<Resource>& resource, gli::format format) override;
     void IASetVertexBuffer(uint32_t slot, const std::shared_ptr<Resource>& resource) override;
     void RSSetShadingRate(ShadingRate shading_rate, const std::array<ShadingRateCombiner, 2>& combiners) override;
+    void SetCullMode(CullMode cull_mode) override;
+    void SetFillMode(FillMode fill_mode) override;
+    void SetDepthBias(int32_t depth_bias) override;
+    void SetDepthStencilState(const DepthStencilDesc& desc) override;
+    void SetPrimitiveTopology(PrimitiveTopology topology) override;
     void BuildBottomLevelAS(const std::shared_ptr<Resource>& src,
                             const std::shared_ptr<Resource>& dst,
                             const std::shared_ptr<Resource>& scratch,
@@ -89,6 +95,10 @@ public:
     void WriteAccelerationStructuresProperties(const std::vector<std::shared_ptr<Resource>>& acceleration_structures,
                                                const std::shared_ptr<QueryHeap>& query_heap,
                                                uint32_t first_query) override;
+    void ResetQueryHeap(const std::shared_ptr<QueryHeap>& query_heap,
+                        uint32_t first_query,
+                        uint32_t query_count) override;
+    void WriteTimestamp(const std::shared_ptr<QueryHeap>& query_heap, uint32_t query) override;
     void ResolveQueryData(const std::shared_ptr<QueryHeap>& query_heap,
                           uint32_t first_query,
                           uint32_t query_count,
@@ -135,4 +145,5 @@ private:
     std::shared_ptr<BindingSet> m_binding_set;
     std::map<uint32_t, std::shared_ptr<Resource>> m_lazy_vertex;
     std::shared_ptr<View> m_shading_rate_image_view;
+    D3D_PRIMITIVE_TOPOLOGY m_primitive_topology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
 };
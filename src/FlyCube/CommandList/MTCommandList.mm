@@ -107,6 +107,11 @@ void MTCommandList::BindBindingSet(const std::shared_ptr<BindingSet>& binding_se
     m_binding_set = std::static_pointer_cast<MTBindingSet>(binding_set);
 }
 
+void MTCommandList::SetRootConstants(const BindKey& bind_key, const void* data, uint32_t size)
+{
+    assert(false);
+}
+
 void MTCommandList::BeginRenderPass(const std::shared_ptr<RenderPass>& render_pass,
                                     const std::shared_ptr<Framebuffer>& framebuffer,
                                     const ClearDesc& clear_desc)
@@ -427,6 +432,17 @@ void MTCommandList::RSSetShadingRate(ShadingRate shading_rate, const std::array<
     assert(false);
 }
 
+// MTDevice::IsDynamicStateSupported is false, these states come from the bound pipeline and draws use triangle lists
+void MTCommandList::SetCullMode(CullMode cull_mode) {}
+
+void MTCommandList::SetFillMode(FillMode fill_mode) {}
+
+void MTCommandList::SetDepthBias(int32_t depth_bias) {}
+
+void MTCommandList::SetDepthStencilState(const DepthStencilDesc& desc) {}
+
+void MTCommandList::SetPrimitiveTopology(PrimitiveTopology topology) {}
+
 void MTCommandList::BuildBottomLevelAS(const std::shared_ptr<Resource>& src,
                                        const std::shared_ptr<Resource>& dst,
                                        const std::shared_ptr<Resource>& scratch,
@@ -617,6 +633,18 @@ void MTCommandList::WriteAccelerationStructuresProperties(
     assert(false);
 }
 
+void MTCommandList::ResetQueryHeap(const std::shared_ptr<QueryHeap>& query_heap,
+                                   uint32_t first_query,
+                                   uint32_t query_count)
+{
+    assert(false);
+}
+
+void MTCommandList::WriteTimestamp(const std::shared_ptr<QueryHeap>& query_heap, uint32_t query)
+{
+    assert(false);
+}
+
 void MTCommandList::ResolveQueryData(const std::shared_ptr<QueryHeap>& query_heap,
                                      uint32_t first_query,
                                      uint32_t query_count,
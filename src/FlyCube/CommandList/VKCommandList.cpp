@@ -2,6 +2,7 @@
 
 #include "Adapter/VKAdapter.h"
 #include "BindingSet/VKBindingSet.h"
+#include "BindingSetLayout/VKBindingSetLayout.h"
 #include "Device/VKDevice.h"
 #include "Framebuffer/VKFramebuffer.h"
 #include "Instance/VKInstance.h"
@@ -66,6 +67,7 @@ void VKCommandList::Reset()
     m_closed = false;
     m_state.reset();
     m_binding_set.reset();
+    ResetDynamicState();
 }
 
 void VKCommandList::Close()
@@ -97,6 +99,33 @@ void VKCommandList::BindPipeline(const std::shared_ptr<Pipeline>& state)
     }
     m_state = std::static_pointer_cast<VKPipeline>(state);
     m_command_list->bindPipeline(GetPipelineBindPoint(m_state->GetPipelineType()), m_state->GetPipeline());
+    if (m_state->GetPipelineType() != PipelineType::kGraphics) {
+        return;
+    }
+
+    if (!m_state->As<VKGraphicsPipeline>().HasDynamicState()) {
+        // Binding baked states invalidates the dynamic ones
+        ResetDynamicState();
+        return;
+    }
+
+    // Dynamic states must be set before drawing, the ones never set start from the desc defaults
+    RasterizerDesc rasterizer_desc = {};
+    if (!m_cull_mode) {
+        SetCullMode(rasterizer_desc.cull_mode);
+    }
+    if (!m_fill_mode) {
+        SetFillMode(rasterizer_desc.fill_mode);
+    }
+    if (!m_depth_bias) {
+        SetDepthBias(rasterizer_desc.depth_bias);
+    }
+    if (!m_depth_stencil_desc) {
+        SetDepthStencilState({});
+    }
+    if (!m_primitive_topology) {
+        SetPrimitiveTopology(PrimitiveTopology::kTriangleList);
+    }
 }
 
 void VKCommandList::BindBindingSet(const std::shared_ptr<BindingSet>& binding_set)
@@ -114,6 +143,14 @@ void VKCommandList::BindBindingSet(const std::shared_ptr<BindingSet>& binding_se
                                        0, descriptor_sets.size(), descriptor_sets.data(), 0, nullptr);
 }
 
+void VKCommandList::SetRootConstants(const BindKey& bind_key, const void* data, uint32_t size)
+{
+    assert(bind_key.is_root_constant);
+    assert(size <= bind_key.count * sizeof(uint32_t));
+    decltype(auto) vk_layout = m_state->GetLayout()->As<VKBindingSetLayout>();
+    m_command_list->pushConstants(m_state->GetPipelineLayout(), vk_layout.GetPushConstantStages(), 0, size, data);
+}
+
 void VKCommandList::BeginRenderPass(const std::shared_ptr<RenderPass>& render_pass,
                                     const std::shared_ptr<Framebuffer>& framebuffer,
                                     const ClearDesc& clear_desc)
@@ -517,6 +554,64 @@ void VKCommandList::RSSetShadingRate(ShadingRate shading_rate, const std::array<
 #endif
 }
 
+void VKCommandList::SetCullMode(CullMode cull_mode)
+{
+    if (m_cull_mode == cull_mode) {
+        return;
+    }
+    m_cull_mode = cull_mode;
+    m_command_list->setCullModeEXT(Convert(cull_mode));
+}
+
+void VKCommandList::SetFillMode(FillMode fill_mode)
+{
+    if (m_fill_mode == fill_mode) {
+        return;
+    }
+    m_fill_mode = fill_mode;
+    m_command_list->setPolygonModeEXT(Convert(fill_mode));
+}
+
+void VKCommandList::SetDepthBias(int32_t depth_bias)
+{
+    if (m_depth_bias == depth_bias) {
+        return;
+    }
+    m_depth_bias = depth_bias;
+    m_command_list->setDepthBiasEnableEXT(depth_bias != 0);
+    m_command_list->setDepthBias(depth_bias, 0.0f, 0.0f);
+}
+
+void VKCommandList::SetDepthStencilState(const DepthStencilDesc& desc)
+{
+    if (m_depth_stencil_desc && !(*m_depth_stencil_desc < desc) && !(desc < *m_depth_stencil_desc)) {
+        return;
+    }
+    m_depth_stencil_desc = desc;
+    m_command_list->setDepthTestEnableEXT(desc.depth_test_enable);
+    m_command_list->setDepthWriteEnableEXT(desc.depth_write_enable);
+    m_command_list->setDepthCompareOpEXT(Convert(desc.depth_func));
+    m_command_list->setDepthBoundsTestEnableEXT(desc.depth_bounds_test_enable);
+    m_command_list->setStencilTestEnableEXT(desc.stencil_enable);
+    m_command_list->setStencilOpEXT(vk::StencilFaceFlagBits::eFront, Convert(desc.front_face.fail_op),
+                                    Convert(desc.front_face.pass_op), Convert(desc.front_face.depth_fail_op),
+                                    Convert(desc.front_face.func));
+    m_command_list->setStencilOpEXT(vk::StencilFaceFlagBits::eBack, Convert(desc.back_face.fail_op),
+                                    Convert(desc.back_face.pass_op), Convert(desc.back_face.depth_fail_op),
+                                    Convert(desc.back_face.func));
+    m_command_list->setStencilCompareMask(vk::StencilFaceFlagBits::eFrontAndBack, desc.stencil_read_mask);
+    m_command_list->setStencilWriteMask(vk::StencilFaceFlagBits::eFrontAndBack, desc.stencil_write_mask);
+}
+
+void VKCommandList::SetPrimitiveTopology(PrimitiveTopology topology)
+{
+    if (m_primitive_topology == topology) {
+        return;
+    }
+    m_primitive_topology = topology;
+    m_command_list->setPrimitiveTopologyEXT(Convert(topology));
+}
+
 void VKCommandList::BuildBottomLevelAS(const std::shared_ptr<Resource>& src,
                                        const std::shared_ptr<Resource>& dst,
                                        const std::shared_ptr<Resource>& scratch,
@@ -753,6 +848,21 @@ void VKCommandList::WriteAccelerationStructuresProperties(
 #endif
 }
 
+void VKCommandList::ResetQueryHeap(const std::shared_ptr<QueryHeap>& query_heap,
+                                   uint32_t first_query,
+                                   uint32_t query_count)
+{
+    decltype(auto) vk_query_heap = query_heap->As<VKQueryHeap>();
+    m_command_list->resetQueryPool(vk_query_heap.GetQueryPool(), first_query, query_count);
+}
+
+void VKCommandList::WriteTimestamp(const std::shared_ptr<QueryHeap>& query_heap, uint32_t query)
+{
+    decltype(auto) vk_query_heap = query_heap->As<VKQueryHeap>();
+    assert(vk_query_heap.GetQueryType() == vk::QueryType::eTimestamp);
+    m_command_list->writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, vk_query_heap.GetQueryPool(), query);
+}
+
 void VKCommandList::ResolveQueryData(const std::shared_ptr<QueryHeap>& query_heap,
                                      uint32_t first_query,
                                      uint32_t query_count,
@@ -761,10 +871,15 @@ void VKCommandList::ResolveQueryData(const std::shared_ptr<QueryHeap>& query_hea
 {
     decltype(auto) vk_query_heap = query_heap->As<VKQueryHeap>();
     auto query_type = vk_query_heap.GetQueryType();
-    assert(query_type == vk::QueryType::eAccelerationStructureCompactedSizeKHR);
+    vk::QueryResultFlags flags = vk::QueryResultFlagBits::eWait;
+    if (query_type == vk::QueryType::eTimestamp) {
+        flags |= vk::QueryResultFlagBits::e64;
+    } else {
+        assert(query_type == vk::QueryType::eAccelerationStructureCompactedSizeKHR);
+    }
     m_command_list->copyQueryPoolResults(vk_query_heap.GetQueryPool(), first_query, query_count,
                                          dst_buffer->As<VKResource>().buffer.res.get(), dst_offset, sizeof(uint64_t),
-                                         vk::QueryResultFlagBits::eWait);
+                                         flags);
 }
 
 void VKCommandList::SetName(const std::string& name)
@@ -780,3 +895,12 @@ vk::CommandBuffer VKCommandList::GetCommandList()
 {
     return m_command_list.get();
 }
+
+void VKCommandList::ResetDynamicState()
+{
+    m_cull_mode.reset();
+    m_fill_mode.reset();
+    m_depth_bias.reset();
+    m_depth_stencil_desc.reset();
+    m_primitive_topology.reset();
+}
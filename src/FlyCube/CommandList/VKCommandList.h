@@ -3,6 +3,8 @@
 
 #include <vulkan/vulkan.hpp>
 
+#include <optional>
+
 class VKDevice;
 class VKPipeline;
 
@@ -13,6 +15,7 @@ public:
     void Close() override;
     void BindPipeline(const std::shared_ptr<Pipeline>& state) override;
     void BindBindingSet(const std::shared_ptr<BindingSet>& binding_set) override;
+    void SetRootConstants(const BindKey& bind_key, const void* data, uint32_t size) override;
     void BeginRenderPass(const std::shared_ptr<RenderPass>& render_pass,
                          const std::shared_ptr<Framebuffer>& framebuffer,
                          const ClearDesc& clear_desc) override;
@@ -56,6 +59,11 @@ public:
     void IASetIndexBuffer(const std::shared_ptr<Resource>& resource, gli::format format) override;
     void IASetVertexBuffer(uint32_t slot, const std::shared_ptr<Resource>& resource) override;
     void RSSetShadingRate(ShadingRate shading_rate, const std::array<ShadingRateCombiner, 2>& combiners) override;
+    void SetCullMode(CullMode cull_mode) override;
+    void SetFillMode(FillMode fill_mode) override;
+    void SetDepthBias(int32_t depth_bias) override;
+    void SetDepthStencilState(const DepthStencilDesc& desc) override;
+    void SetPrimitiveTopology(PrimitiveTopology topology) override;
     void BuildBottomLevelAS(const std::shared_ptr<Resource>& src,
                             const std::shared_ptr<Resource>& dst,
                             const std::shared_ptr<Resource>& scratch,
@@ -85,6 +93,10 @@ public:
     void WriteAccelerationStructuresProperties(const std::vector<std::shared_ptr<Resource>>& acceleration_structures,
                                                const std::shared_ptr<QueryHeap>& query_heap,
                                                uint32_t first_query) override;
+    void ResetQueryHeap(const std::shared_ptr<QueryHeap>& query_heap,
+                        uint32_t first_query,
+                        uint32_t query_count) override;
+    void WriteTimestamp(const std::shared_ptr<QueryHeap>& query_heap, uint32_t query) override;
     void ResolveQueryData(const std::shared_ptr<QueryHeap>& query_heap,
                           uint32_t first_query,
                           uint32_t query_count,
@@ -95,6 +107,7 @@ public:
     vk::CommandBuffer GetCommandList();
 
 private:
+    void ResetDynamicState();
     void BuildAccelerationStructure(vk::AccelerationStructureCreateInfoKHR& build_info,
                                     const vk::Buffer& instance_data,
                                     uint64_t instance_offset,
@@ -108,4 +121,10 @@ private:
     bool m_closed = false;
     std::shared_ptr<VKPipeline> m_state;
     std::shared_ptr<BindingSet> m_binding_set;
+    // Last values of the dynamic states, empty when unknown
+    std::optional<CullMode> m_cull_mode;
+    std::optional<FillMode> m_fill_mode;
+    std::optional<int32_t> m_depth_bias;
+    std::optional<DepthStencilDesc> m_depth_stencil_desc;
+    std::optional<PrimitiveTopology> m_primitive_topology;
 };
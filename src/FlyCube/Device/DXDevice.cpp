@@ -13,11 +13,13 @@
 #include "Pipeline/DXRayTracingPipeline.h"
 #include "Program/ProgramBase.h"
 #include "QueryHeap/DXRayTracingQueryHeap.h"
+#include "QueryHeap/DXTimestampQueryHeap.h"
 #include "RenderPass/DXRenderPass.h"
 #include "Shader/ShaderBase.h"
 #include "Swapchain/DXSwapchain.h"
 #include "Utilities/DXGIFormatHelper.h"
 #include "Utilities/DXUtility.h"
+#include "Utilities/ThreadPool.h"
 #include "View/DXView.h"
 
 #include <directx/d3dx12.h>
@@ -159,6 +161,12 @@ DXDevice::DXDevice(DXAdapter& adapter)
         m_is_under_graphics_debugger |= !!gpa;
     }
 
+    D3D12_FEATURE_DATA_D3D12_OPTIONS4 feature_support4 = {};
+    if (SUCCEEDED(
+            m_device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS4, &feature_support4, sizeof(feature_support4)))) {
+        m_is_native_16bit_shader_ops_supported = feature_support4.Native16BitShaderOpsSupported;
+    }
+
     D3D12_FEATURE_DATA_D3D12_OPTIONS5 feature_support5 = {};
     if (SUCCEEDED(
             m_device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS5, &feature_support5, sizeof(feature_support5)))) {
@@ -217,6 +225,11 @@ DXDevice::DXDevice(DXAdapter& adapter)
     }
 }
 
+DXDevice::~DXDevice()
+{
+    WaitPendingPipelines();
+}
+
 std::shared_ptr<Memory> DXDevice::AllocateMemory(uint64_t size, MemoryType memory_type, uint32_t memory_type_bits)
 {
     return std::make_shared<DXMemory>(*this, size, memory_type, memory_type_bits);
@@ -420,9 +433,7 @@ std::shared_ptr<Framebuffer> DXDevice::CreateFramebuffer(const FramebufferDesc&
     return std::make_shared<DXFramebuffer>(desc);
 }
 
-std::shared_ptr<Shader> DXDevice::CreateShader(const std::vector<uint8_t>& blob,
-                                               ShaderBlobType blob_type,
-                                               ShaderType shader_type)
+std::shared_ptr<Shader> DXDevice::CreateShader(const ShaderBlob& blob, ShaderBlobType blob_type, ShaderType shader_type)
 {
     return std::make_shared<ShaderBase>(blob, blob_type, shader_type);
 }
@@ -432,6 +443,13 @@ std::shared_ptr<Shader> DXDevice::CompileShader(const ShaderDesc& desc)
     return std::make_shared<ShaderBase>(desc, ShaderBlobType::kDXIL);
 }
 
+std::vector<std::shared_ptr<Shader>> DXDevice::CompileShaders(const std::vector<ShaderDesc>& descs)
+{
+    std::vector<std::shared_ptr<Shader>> shaders(descs.size());
+    GetThreadPool().ParallelFor(descs.size(), [&](size_t i) { shaders[i] = CompileShader(descs[i]); });
+    return shaders;
+}
+
 std::shared_ptr<Program> DXDevice::CreateProgram(const std::vector<std::shared_ptr<Shader>>& shaders)
 {
     return std::make_shared<ProgramBase>(shaders);
@@ -439,17 +457,18 @@ std::shared_ptr<Program> DXDevice::CreateProgram(const std::vector<std::shared_p
 
 std::shared_ptr<Pipeline> DXDevice::CreateGraphicsPipeline(const GraphicsPipelineDesc& desc)
 {
-    return std::make_shared<DXGraphicsPipeline>(*this, desc);
+    return m_pipeline_deduplicator.GetOrCreate(desc, [&] { return std::make_shared<DXGraphicsPipeline>(*this, desc); });
 }
 
 std::shared_ptr<Pipeline> DXDevice::CreateComputePipeline(const ComputePipelineDesc& desc)
 {
-    return std::make_shared<DXComputePipeline>(*this, desc);
+    return m_pipeline_deduplicator.GetOrCreate(desc, [&] { return std::make_shared<DXComputePipeline>(*this, desc); });
 }
 
 std::shared_ptr<Pipeline> DXDevice::CreateRayTracingPipeline(const RayTracingPipelineDesc& desc)
 {
-    return std::make_shared<DXRayTracingPipeline>(*this, desc);
+    return m_pipeline_deduplicator.GetOrCreate(
+        desc, [&] { return std::make_shared<DXRayTracingPipeline>(*this, desc); });
 }
 
 std::shared_ptr<Resource> DXDevice::CreateAccelerationStructure(AccelerationStructureType type,
@@ -467,6 +486,8 @@ std::shared_ptr<QueryHeap> DXDevice::CreateQueryHeap(QueryHeapType type, uint32_
 {
     if (type == QueryHeapType::kAccelerationStructureCompactedSize) {
         return std::make_shared<DXRayTracingQueryHeap>(*this, type, count);
+    } else if (type == QueryHeapType::kTimestamp) {
+        return std::make_shared<DXTimestampQueryHeap>(*this, type, count);
     }
     return {};
 }
@@ -513,6 +534,31 @@ bool DXDevice::IsGeometryShaderSupported() const
     return true;
 }
 
+uint64_t DXDevice::GetTimestampFrequency(CommandListType type) const
+{
+    // Queues of different types may run their timestamp counters at different rates, copy queues may have none
+    uint64_t frequency = 0;
+    if (FAILED(m_command_queues.at(type)->GetQueue()->GetTimestampFrequency(&frequency))) {
+        return 0;
+    }
+    return frequency;
+}
+
+bool DXDevice::IsFloat16Supported() const
+{
+    return m_is_native_16bit_shader_ops_supported;
+}
+
+bool DXDevice::IsInt16Supported() const
+{
+    return m_is_native_16bit_shader_ops_supported;
+}
+
+bool DXDevice::IsDynamicStateSupported() const
+{
+    return false;
+}
+
 uint32_t DXDevice::GetShadingRateImageTileSize() const
 {
     return m_shading_rate_image_tile_size;
@@ -577,6 +623,19 @@ ShaderBlobType DXDevice::GetSupportedShaderBlobType() const
     return ShaderBlobType::kDXIL;
 }
 
+bool DXDevice::SavePipelineCache()
+{
+    return false;
+}
+
+PipelineCacheStats DXDevice::GetPipelineCacheStats() const
+{
+    PipelineCacheStats stats = {};
+    stats.hit_count = m_pipeline_deduplicator.GetHitCount();
+    stats.miss_count = m_pipeline_deduplicator.GetMissCount();
+    return stats;
+}
+
 DXAdapter& DXDevice::GetAdapter()
 {
     return m_adapter;
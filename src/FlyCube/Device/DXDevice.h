@@ -2,6 +2,7 @@
 #include "CPUDescriptorPool/DXCPUDescriptorPool.h"
 #include "Device/Device.h"
 #include "GPUDescriptorPool/DXGPUDescriptorPool.h"
+#include "Pipeline/PipelineDeduplicator.h"
 
 #include <directx/d3d12.h>
 #include <dxgi.h>
@@ -21,6 +22,7 @@ D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS Convert(BuildAccelerationStr
 class DXDevice : public Device {
 public:
     DXDevice(DXAdapter& adapter);
+    ~DXDevice();
     std::shared_ptr<Memory> AllocateMemory(uint64_t size, MemoryType memory_type, uint32_t memory_type_bits) override;
     std::shared_ptr<CommandQueue> GetCommandQueue(CommandListType type) override;
     uint32_t GetTextureDataPitchAlignment() const override;
@@ -46,10 +48,11 @@ public:
     std::shared_ptr<BindingSet> CreateBindingSet(const std::shared_ptr<BindingSetLayout>& layout) override;
     std::shared_ptr<RenderPass> CreateRenderPass(const RenderPassDesc& desc) override;
     std::shared_ptr<Framebuffer> CreateFramebuffer(const FramebufferDesc& desc) override;
-    std::shared_ptr<Shader> CreateShader(const std::vector<uint8_t>& blob,
+    std::shared_ptr<Shader> CreateShader(const ShaderBlob& blob,
                                          ShaderBlobType blob_type,
                                          ShaderType shader_type) override;
     std::shared_ptr<Shader> CompileShader(const ShaderDesc& desc) override;
+    std::vector<std::shared_ptr<Shader>> CompileShaders(const std::vector<ShaderDesc>& descs) override;
     std::shared_ptr<Program> CreateProgram(const std::vector<std::shared_ptr<Shader>>& shaders) override;
     std::shared_ptr<Pipeline> CreateGraphicsPipeline(const GraphicsPipelineDesc& desc) override;
     std::shared_ptr<Pipeline> CreateComputePipeline(const ComputePipelineDesc& desc) override;
@@ -64,16 +67,22 @@ public:
     bool IsMeshShadingSupported() const override;
     bool IsDrawIndirectCountSupported() const override;
     bool IsGeometryShaderSupported() const override;
+    bool IsFloat16Supported() const override;
+    bool IsInt16Supported() const override;
+    bool IsDynamicStateSupported() const override;
     uint32_t GetShadingRateImageTileSize() const override;
     MemoryBudget GetMemoryBudget() const override;
     uint32_t GetShaderGroupHandleSize() const override;
     uint32_t GetShaderRecordAlignment() const override;
     uint32_t GetShaderTableAlignment() const override;
+    uint64_t GetTimestampFrequency(CommandListType type) const override;
     RaytracingASPrebuildInfo GetBLASPrebuildInfo(const std::vector<RaytracingGeometryDesc>& descs,
                                                  BuildAccelerationStructureFlags flags) const override;
     RaytracingASPrebuildInfo GetTLASPrebuildInfo(uint32_t instance_count,
                                                  BuildAccelerationStructureFlags flags) const override;
     ShaderBlobType GetSupportedShaderBlobType() const override;
+    bool SavePipelineCache() override;
+    PipelineCacheStats GetPipelineCacheStats() const override;
 
     DXAdapter& GetAdapter();
     ComPtr<ID3D12Device> GetDevice();
@@ -99,9 +108,11 @@ private:
     bool m_is_render_passes_supported = false;
     bool m_is_variable_rate_shading_supported = false;
     bool m_is_mesh_shading_supported = false;
+    bool m_is_native_16bit_shader_ops_supported = false;
     uint32_t m_shading_rate_image_tile_size = 0;
     bool m_is_under_graphics_debugger = false;
     bool m_is_create_not_zeroed_available = false;
     std::map<std::pair<D3D12_INDIRECT_ARGUMENT_TYPE, uint32_t>, ComPtr<ID3D12CommandSignature>>
         m_command_signature_cache;
+    PipelineDeduplicator m_pipeline_deduplicator;
 };
@@ -0,0 +1,45 @@
+#include "Device/Device.h"
+
+#include "Utilities/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+
+std::shared_ptr<PendingPipeline> Device::CreateGraphicsPipelineAsync(const GraphicsPipelineDesc& desc)
+{
+    return CreatePipelineAsync([this, desc] { return CreateGraphicsPipeline(desc); });
+}
+
+std::shared_ptr<PendingPipeline> Device::CreateComputePipelineAsync(const ComputePipelineDesc& desc)
+{
+    return CreatePipelineAsync([this, desc] { return CreateComputePipeline(desc); });
+}
+
+std::shared_ptr<PendingPipeline> Device::CreateRayTracingPipelineAsync(const RayTracingPipelineDesc& desc)
+{
+    return CreatePipelineAsync([this, desc] { return CreateRayTracingPipeline(desc); });
+}
+
+void Device::WaitPendingPipelines()
+{
+    std::lock_guard<std::mutex> lock(m_pending_pipelines_mutex);
+    for (const auto& future : m_pending_pipelines) {
+        future.wait();
+    }
+    m_pending_pipelines.clear();
+}
+
+std::shared_ptr<PendingPipeline> Device::CreatePipelineAsync(std::function<std::shared_ptr<Pipeline>()> create)
+{
+    auto future = GetThreadPool().Submit(std::move(create)).share();
+    std::lock_guard<std::mutex> lock(m_pending_pipelines_mutex);
+    // Finished pipelines no longer reference the device
+    m_pending_pipelines.erase(std::remove_if(m_pending_pipelines.begin(), m_pending_pipelines.end(),
+                                             [](const auto& pending) {
+                                                 return pending.wait_for(std::chrono::seconds(0)) ==
+                                                        std::future_status::ready;
+                                             }),
+                              m_pending_pipelines.end());
+    m_pending_pipelines.push_back(future);
+    return std::make_shared<PendingPipeline>(std::move(future));
+}
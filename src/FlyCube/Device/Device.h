@@ -7,6 +7,7 @@
 #include "Instance/BaseTypes.h"
 #include "Instance/QueryInterface.h"
 #include "Memory/Memory.h"
+#include "Pipeline/PendingPipeline.h"
 #include "Pipeline/Pipeline.h"
 #include "Program/Program.h"
 #include "QueryHeap/QueryHeap.h"
@@ -16,7 +17,10 @@
 
 #include <gli/format.hpp>
 
+#include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 struct MemoryBudget {
@@ -24,6 +28,17 @@ struct MemoryBudget {
     uint64_t usage;
 };
 
+// Compare creation_time between runs with and without a saved pipeline cache to measure its savings
+struct PipelineCacheStats {
+    // Size of the data loaded at device creation, 0 when no valid cache file was found
+    uint64_t loaded_size = 0;
+    uint64_t pipeline_count = 0;
+    uint64_t creation_time_us = 0;
+    // Create*Pipeline calls answered with a live pipeline created from an equivalent desc
+    uint64_t hit_count = 0;
+    uint64_t miss_count = 0;
+};
+
 class Device : public QueryInterface {
 public:
     virtual ~Device() = default;
@@ -54,14 +69,19 @@ public:
     virtual std::shared_ptr<BindingSet> CreateBindingSet(const std::shared_ptr<BindingSetLayout>& layout) = 0;
     virtual std::shared_ptr<RenderPass> CreateRenderPass(const RenderPassDesc& desc) = 0;
     virtual std::shared_ptr<Framebuffer> CreateFramebuffer(const FramebufferDesc& desc) = 0;
-    virtual std::shared_ptr<Shader> CreateShader(const std::vector<uint8_t>& blob,
+    virtual std::shared_ptr<Shader> CreateShader(const ShaderBlob& blob,
                                                  ShaderBlobType blob_type,
                                                  ShaderType shader_type) = 0;
     virtual std::shared_ptr<Shader> CompileShader(const ShaderDesc& desc) = 0;
+    virtual std::vector<std::shared_ptr<Shader>> CompileShaders(const std::vector<ShaderDesc>& descs) = 0;
     virtual std::shared_ptr<Program> CreateProgram(const std::vector<std::shared_ptr<Shader>>& shaders) = 0;
     virtual std::shared_ptr<Pipeline> CreateGraphicsPipeline(const GraphicsPipelineDesc& desc) = 0;
     virtual std::shared_ptr<Pipeline> CreateComputePipeline(const ComputePipelineDesc& desc) = 0;
     virtual std::shared_ptr<Pipeline> CreateRayTracingPipeline(const RayTracingPipelineDesc& desc) = 0;
+    // Create the pipeline on the thread pool, the device waits for the pending pipelines before it is destroyed
+    std::shared_ptr<PendingPipeline> CreateGraphicsPipelineAsync(const GraphicsPipelineDesc& desc);
+    std::shared_ptr<PendingPipeline> CreateComputePipelineAsync(const ComputePipelineDesc& desc);
+    std::shared_ptr<PendingPipeline> CreateRayTracingPipelineAsync(const RayTracingPipelineDesc& desc);
     virtual std::shared_ptr<Resource> CreateAccelerationStructure(AccelerationStructureType type,
                                                                   const std::shared_ptr<Resource>& resource,
                                                                   uint64_t offset) = 0;
@@ -72,14 +92,33 @@ public:
     virtual bool IsMeshShadingSupported() const = 0;
     virtual bool IsDrawIndirectCountSupported() const = 0;
     virtual bool IsGeometryShaderSupported() const = 0;
+    virtual bool IsFloat16Supported() const = 0;
+    virtual bool IsInt16Supported() const = 0;
+    // Graphics pipelines may be created with GraphicsPipelineDesc::dynamic_state
+    virtual bool IsDynamicStateSupported() const = 0;
     virtual uint32_t GetShadingRateImageTileSize() const = 0;
     virtual MemoryBudget GetMemoryBudget() const = 0;
     virtual uint32_t GetShaderGroupHandleSize() const = 0;
     virtual uint32_t GetShaderRecordAlignment() const = 0;
     virtual uint32_t GetShaderTableAlignment() const = 0;
+    // Ticks per second of kTimestamp queries written on queues of this type, 0 if they are not supported
+    virtual uint64_t GetTimestampFrequency(CommandListType type) const = 0;
     virtual RaytracingASPrebuildInfo GetBLASPrebuildInfo(const std::vector<RaytracingGeometryDesc>& descs,
                                                          BuildAccelerationStructureFlags flags) const = 0;
     virtual RaytracingASPrebuildInfo GetTLASPrebuildInfo(uint32_t instance_count,
                                                          BuildAccelerationStructureFlags flags) const = 0;
     virtual ShaderBlobType GetSupportedShaderBlobType() const = 0;
+    // Writes the driver pipeline cache to disk, returns false if the backend doesn't persist one
+    virtual bool SavePipelineCache() = 0;
+    virtual PipelineCacheStats GetPipelineCacheStats() const = 0;
+
+protected:
+    // Called first by the backend destructors, pending pipelines are still being created with backend objects
+    void WaitPendingPipelines();
+
+private:
+    std::shared_ptr<PendingPipeline> CreatePipelineAsync(std::function<std::shared_ptr<Pipeline>()> create);
+
+    std::mutex m_pending_pipelines_mutex;
+    std::vector<std::shared_future<std::shared_ptr<Pipeline>>> m_pending_pipelines;
 };
@@ -1,6 +1,7 @@
 #pragma once
 #include "Device/Device.h"
 #include "GPUDescriptorPool/MTGPUBindlessArgumentBuffer.h"
+#include "Pipeline/PipelineDeduplicator.h"
 
 #include <MVKPixelFormats.h>
 #import <Metal/Metal.h>
@@ -37,6 +38,7 @@ class MTInstance;
 class MTDevice : public Device, protected MVKPhysicalDeviceImpl {
 public:
     MTDevice(MTInstance& instance, const id<MTLDevice>& device);
+    ~MTDevice();
     std::shared_ptr<Memory> AllocateMemory(uint64_t size, MemoryType memory_type, uint32_t memory_type_bits) override;
     std::shared_ptr<CommandQueue> GetCommandQueue(CommandListType type) override;
     uint32_t GetTextureDataPitchAlignment() const override;
@@ -62,10 +64,11 @@ public:
     std::shared_ptr<BindingSet> CreateBindingSet(const std::shared_ptr<BindingSetLayout>& layout) override;
     std::shared_ptr<RenderPass> CreateRenderPass(const RenderPassDesc& desc) override;
     std::shared_ptr<Framebuffer> CreateFramebuffer(const FramebufferDesc& desc) override;
-    std::shared_ptr<Shader> CreateShader(const std::vector<uint8_t>& blob,
+    std::shared_ptr<Shader> CreateShader(const ShaderBlob& blob,
                                          ShaderBlobType blob_type,
                                          ShaderType shader_type) override;
     std::shared_ptr<Shader> CompileShader(const ShaderDesc& desc) override;
+    std::vector<std::shared_ptr<Shader>> CompileShaders(const std::vector<ShaderDesc>& descs) override;
     std::shared_ptr<Program> CreateProgram(const std::vector<std::shared_ptr<Shader>>& shaders) override;
     std::shared_ptr<Pipeline> CreateGraphicsPipeline(const GraphicsPipelineDesc& desc) override;
     std::shared_ptr<Pipeline> CreateComputePipeline(const ComputePipelineDesc& desc) override;
@@ -80,16 +83,22 @@ public:
     bool IsMeshShadingSupported() const override;
     bool IsDrawIndirectCountSupported() const override;
     bool IsGeometryShaderSupported() const override;
+    bool IsFloat16Supported() const override;
+    bool IsInt16Supported() const override;
+    bool IsDynamicStateSupported() const override;
     uint32_t GetShadingRateImageTileSize() const override;
     MemoryBudget GetMemoryBudget() const override;
     uint32_t GetShaderGroupHandleSize() const override;
     uint32_t GetShaderRecordAlignment() const override;
     uint32_t GetShaderTableAlignment() const override;
+    uint64_t GetTimestampFrequency(CommandListType type) const override;
     RaytracingASPrebuildInfo GetBLASPrebuildInfo(const std::vector<RaytracingGeometryDesc>& descs,
                                                  BuildAccelerationStructureFlags flags) const override;
     RaytracingASPrebuildInfo GetTLASPrebuildInfo(uint32_t instance_count,
                                                  BuildAccelerationStructureFlags flags) const override;
     ShaderBlobType GetSupportedShaderBlobType() const override;
+    bool SavePipelineCache() override;
+    PipelineCacheStats GetPipelineCacheStats() const override;
 
     const id<MTLDevice>& GetDevice() const;
     MVKPixelFormats& GetMVKPixelFormats();
@@ -107,6 +116,7 @@ private:
     MVKPixelFormats m_mvk_pixel_formats;
     std::shared_ptr<MTCommandQueue> m_command_queue;
     MTGPUBindlessArgumentBuffer m_bindless_argument_buffer;
+    PipelineDeduplicator m_pipeline_deduplicator;
 };
 
 MTLAccelerationStructureTriangleGeometryDescriptor* FillRaytracingGeometryDesc(const BufferDesc& vertex,
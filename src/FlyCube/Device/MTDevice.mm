@@ -15,6 +15,7 @@
 #include "Resource/MTResource.h"
 #include "Shader/MTShader.h"
 #include "Swapchain/MTSwapchain.h"
+#include "Utilities/ThreadPool.h"
 #include "View/MTView.h"
 
 MTDevice::MTDevice(MTInstance& instance, const id<MTLDevice>& device)
@@ -26,6 +27,11 @@ MTDevice::MTDevice(MTInstance& instance, const id<MTLDevice>& device)
     m_command_queue = std::make_shared<MTCommandQueue>(*this);
 }
 
+MTDevice::~MTDevice()
+{
+    WaitPendingPipelines();
+}
+
 std::shared_ptr<Memory> MTDevice::AllocateMemory(uint64_t size, MemoryType memory_type, uint32_t memory_type_bits)
 {
     return std::make_shared<MTMemory>(*this, size, memory_type, memory_type_bits);
@@ -164,9 +170,7 @@ std::shared_ptr<Framebuffer> MTDevice::CreateFramebuffer(const FramebufferDesc&
     return std::make_shared<MTFramebuffer>(desc);
 }
 
-std::shared_ptr<Shader> MTDevice::CreateShader(const std::vector<uint8_t>& blob,
-                                               ShaderBlobType blob_type,
-                                               ShaderType shader_type)
+std::shared_ptr<Shader> MTDevice::CreateShader(const ShaderBlob& blob, ShaderBlobType blob_type, ShaderType shader_type)
 {
     return std::make_shared<MTShader>(*this, blob, blob_type, shader_type);
 }
@@ -176,6 +180,13 @@ std::shared_ptr<Shader> MTDevice::CompileShader(const ShaderDesc& desc)
     return std::make_shared<MTShader>(*this, desc, ShaderBlobType::kSPIRV);
 }
 
+std::vector<std::shared_ptr<Shader>> MTDevice::CompileShaders(const std::vector<ShaderDesc>& descs)
+{
+    std::vector<std::shared_ptr<Shader>> shaders(descs.size());
+    GetThreadPool().ParallelFor(descs.size(), [&](size_t i) { shaders[i] = CompileShader(descs[i]); });
+    return shaders;
+}
+
 std::shared_ptr<Program> MTDevice::CreateProgram(const std::vector<std::shared_ptr<Shader>>& shaders)
 {
     return std::make_shared<ProgramBase>(shaders);
@@ -183,12 +194,12 @@ std::shared_ptr<Program> MTDevice::CreateProgram(const std::vector<std::shared_p
 
 std::shared_ptr<Pipeline> MTDevice::CreateGraphicsPipeline(const GraphicsPipelineDesc& desc)
 {
-    return std::make_shared<MTGraphicsPipeline>(*this, desc);
+    return m_pipeline_deduplicator.GetOrCreate(desc, [&] { return std::make_shared<MTGraphicsPipeline>(*this, desc); });
 }
 
 std::shared_ptr<Pipeline> MTDevice::CreateComputePipeline(const ComputePipelineDesc& desc)
 {
-    return std::make_shared<MTComputePipeline>(*this, desc);
+    return m_pipeline_deduplicator.GetOrCreate(desc, [&] { return std::make_shared<MTComputePipeline>(*this, desc); });
 }
 
 std::shared_ptr<Pipeline> MTDevice::CreateRayTracingPipeline(const RayTracingPipelineDesc& desc)
@@ -244,6 +255,26 @@ bool MTDevice::IsGeometryShaderSupported() const
     return false;
 }
 
+uint64_t MTDevice::GetTimestampFrequency(CommandListType type) const
+{
+    return 0;
+}
+
+bool MTDevice::IsFloat16Supported() const
+{
+    return true;
+}
+
+bool MTDevice::IsInt16Supported() const
+{
+    return true;
+}
+
+bool MTDevice::IsDynamicStateSupported() const
+{
+    return false;
+}
+
 uint32_t MTDevice::GetShadingRateImageTileSize() const
 {
     assert(false);
@@ -357,6 +388,19 @@ ShaderBlobType MTDevice::GetSupportedShaderBlobType() const
     return ShaderBlobType::kSPIRV;
 }
 
+bool MTDevice::SavePipelineCache()
+{
+    return false;
+}
+
+PipelineCacheStats MTDevice::GetPipelineCacheStats() const
+{
+    PipelineCacheStats stats = {};
+    stats.hit_count = m_pipeline_deduplicator.GetHitCount();
+    stats.miss_count = m_pipeline_deduplicator.GetMissCount();
+    return stats;
+}
+
 const id<MTLDevice>& MTDevice::GetDevice() const
 {
     return m_device;
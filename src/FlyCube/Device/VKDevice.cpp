@@ -15,8 +15,10 @@
 #include "Program/ProgramBase.h"
 #include "QueryHeap/VKQueryHeap.h"
 #include "RenderPass/VKRenderPass.h"
-#include "Shader/ShaderBase.h"
+#include "Shader/VKShader.h"
 #include "Swapchain/VKSwapchain.h"
+#include "Utilities/SystemUtils.h"
+#include "Utilities/ThreadPool.h"
 #include "Utilities/VKUtility.h"
 #include "View/VKView.h"
 
@@ -145,9 +147,17 @@ VKDevice::VKDevice(VKAdapter& adapter)
         VK_EXT_MEMORY_BUDGET_EXTENSION_NAME,
         VK_EXT_MESH_SHADER_EXTENSION_NAME,
         VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME,
+        VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,
+        VK_KHR_MAINTENANCE_5_EXTENSION_NAME,
+        VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME,
+        VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME,
+        VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME,
     };
 
     std::vector<const char*> found_extension;
+    bool has_dynamic_rendering_extension = false;
+    bool has_maintenance5_extension = false;
+    uint32_t extended_dynamic_state_extension_count = 0;
     for (const auto& extension : extensions) {
         if (req_extension.count(extension.extensionName.data())) {
             found_extension.push_back(extension.extensionName);
@@ -168,6 +178,17 @@ VKDevice::VKDevice(VKAdapter& adapter)
         if (std::string(extension.extensionName.data()) == VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) {
             m_draw_indirect_count_supported = true;
         }
+        if (std::string(extension.extensionName.data()) == VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) {
+            has_dynamic_rendering_extension = true;
+        }
+        if (std::string(extension.extensionName.data()) == VK_KHR_MAINTENANCE_5_EXTENSION_NAME) {
+            has_maintenance5_extension = true;
+        }
+        if (std::string(extension.extensionName.data()) == VK_EXT_EXTENDED_DYNAMIC_STATE_EXTENSION_NAME ||
+            std::string(extension.extensionName.data()) == VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME ||
+            std::string(extension.extensionName.data()) == VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME) {
+            ++extended_dynamic_state_extension_count;
+        }
     }
 
     void* device_create_info_next = nullptr;
@@ -231,9 +252,48 @@ VKDevice::VKDevice(VKAdapter& adapter)
         queue_create_info.pQueuePriorities = &queue_priority;
     }
 
-    auto physical_device_features = m_adapter.GetPhysicalDevice().getFeatures();
+    void* physical_device_features_next = nullptr;
+    auto add_physical_device_features = [&](auto& features) {
+        features.pNext = physical_device_features_next;
+        physical_device_features_next = &features;
+    };
+
+    vk::PhysicalDeviceMaintenance5FeaturesKHR physical_device_maintenance5_features = {};
+    // VK_KHR_maintenance5 depends on VK_KHR_dynamic_rendering with the Vulkan 1.2 instance
+    if (has_dynamic_rendering_extension && has_maintenance5_extension) {
+        add_physical_device_features(physical_device_maintenance5_features);
+    }
+
+    vk::PhysicalDeviceExtendedDynamicStateFeaturesEXT physical_device_extended_dynamic_state_features = {};
+    vk::PhysicalDeviceExtendedDynamicState2FeaturesEXT physical_device_extended_dynamic_state2_features = {};
+    vk::PhysicalDeviceExtendedDynamicState3FeaturesEXT physical_device_extended_dynamic_state3_features = {};
+    if (extended_dynamic_state_extension_count == 3) {
+        add_physical_device_features(physical_device_extended_dynamic_state_features);
+        add_physical_device_features(physical_device_extended_dynamic_state2_features);
+        add_physical_device_features(physical_device_extended_dynamic_state3_features);
+    }
+
+    vk::PhysicalDeviceVulkan11Features physical_device_vulkan11_features = {};
+    vk::PhysicalDeviceVulkan12Features physical_device_vulkan12_features = {};
+    physical_device_vulkan11_features.pNext = &physical_device_vulkan12_features;
+    physical_device_vulkan12_features.pNext = physical_device_features_next;
+    vk::PhysicalDeviceFeatures2 physical_device_features2 = {};
+    physical_device_features2.pNext = &physical_device_vulkan11_features;
+    m_adapter.GetPhysicalDevice().getFeatures2(&physical_device_features2);
+    const vk::PhysicalDeviceFeatures& physical_device_features = physical_device_features2.features;
     m_geometry_shader_supported = physical_device_features.geometryShader;
 
+    // 16-bit values in buffers are only usable together with the 16-bit storage features
+    bool is_16bit_storage_supported = physical_device_vulkan11_features.storageBuffer16BitAccess &&
+                                      physical_device_vulkan11_features.uniformAndStorageBuffer16BitAccess;
+    m_is_float16_supported = physical_device_vulkan12_features.shaderFloat16 && is_16bit_storage_supported;
+    m_is_int16_supported = physical_device_features.shaderInt16 && is_16bit_storage_supported;
+    m_is_maintenance5_supported = physical_device_maintenance5_features.maintenance5;
+    // Polygon mode is the only state needed from VK_EXT_extended_dynamic_state3
+    m_is_dynamic_state_supported = physical_device_extended_dynamic_state_features.extendedDynamicState &&
+                                   physical_device_extended_dynamic_state2_features.extendedDynamicState2 &&
+                                   physical_device_extended_dynamic_state3_features.extendedDynamicState3PolygonMode;
+
     vk::PhysicalDeviceFeatures device_features = {};
     device_features.textureCompressionBC = physical_device_features.textureCompressionBC;
     device_features.vertexPipelineStoresAndAtomics = physical_device_features.vertexPipelineStoresAndAtomics;
@@ -243,6 +303,17 @@ VKDevice::VKDevice(VKAdapter& adapter)
     device_features.geometryShader = physical_device_features.geometryShader;
     device_features.imageCubeArray = physical_device_features.imageCubeArray;
     device_features.shaderImageGatherExtended = physical_device_features.shaderImageGatherExtended;
+    device_features.shaderInt16 = m_is_int16_supported;
+    device_features.fillModeNonSolid = physical_device_features.fillModeNonSolid;
+
+    vk::PhysicalDeviceVulkan11Features device_vulkan11_features = {};
+    if (m_is_float16_supported || m_is_int16_supported) {
+        device_vulkan11_features.storageBuffer16BitAccess = true;
+        device_vulkan11_features.uniformAndStorageBuffer16BitAccess = true;
+        device_vulkan11_features.storagePushConstant16 = physical_device_vulkan11_features.storagePushConstant16;
+        device_vulkan11_features.storageInputOutput16 = physical_device_vulkan11_features.storageInputOutput16;
+    }
+    add_extension(device_vulkan11_features);
 
     vk::PhysicalDeviceVulkan12Features device_vulkan12_features = {};
     device_vulkan12_features.drawIndirectCount = m_draw_indirect_count_supported;
@@ -250,8 +321,27 @@ VKDevice::VKDevice(VKAdapter& adapter)
     device_vulkan12_features.timelineSemaphore = true;
     device_vulkan12_features.runtimeDescriptorArray = true;
     device_vulkan12_features.descriptorBindingVariableDescriptorCount = true;
+    device_vulkan12_features.shaderFloat16 = m_is_float16_supported;
     add_extension(device_vulkan12_features);
 
+    vk::PhysicalDeviceMaintenance5FeaturesKHR maintenance5_feature = {};
+    maintenance5_feature.maintenance5 = true;
+    if (m_is_maintenance5_supported) {
+        add_extension(maintenance5_feature);
+    }
+
+    vk::PhysicalDeviceExtendedDynamicStateFeaturesEXT extended_dynamic_state_feature = {};
+    extended_dynamic_state_feature.extendedDynamicState = true;
+    vk::PhysicalDeviceExtendedDynamicState2FeaturesEXT extended_dynamic_state2_feature = {};
+    extended_dynamic_state2_feature.extendedDynamicState2 = true;
+    vk::PhysicalDeviceExtendedDynamicState3FeaturesEXT extended_dynamic_state3_feature = {};
+    extended_dynamic_state3_feature.extendedDynamicState3PolygonMode = true;
+    if (m_is_dynamic_state_supported) {
+        add_extension(extended_dynamic_state_feature);
+        add_extension(extended_dynamic_state2_feature);
+        add_extension(extended_dynamic_state3_feature);
+    }
+
     vk::PhysicalDeviceMeshShaderFeaturesNV mesh_shader_feature = {};
     mesh_shader_feature.taskShader = true;
     mesh_shader_feature.meshShader = true;
@@ -291,6 +381,12 @@ VKDevice::VKDevice(VKAdapter& adapter)
     VULKAN_HPP_DEFAULT_DISPATCHER.init(m_device.get());
 #endif
 
+    std::string pipeline_cache_dir = GetEnvironmentVar("FLYCUBE_PIPELINE_CACHE_DIR");
+    if (pipeline_cache_dir.empty()) {
+        pipeline_cache_dir = GetExecutableDir() + "/PipelineCache";
+    }
+    m_pipeline_cache = std::make_unique<VKPipelineCache>(m_device.get(), m_device_properties, pipeline_cache_dir);
+
     for (auto& queue_info : m_queues_info) {
         vk::CommandPoolCreateInfo cmd_pool_create_info = {};
         cmd_pool_create_info.flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer;
@@ -301,6 +397,12 @@ VKDevice::VKDevice(VKAdapter& adapter)
     }
 }
 
+VKDevice::~VKDevice()
+{
+    WaitPendingPipelines();
+    SavePipelineCache();
+}
+
 std::shared_ptr<Memory> VKDevice::AllocateMemory(uint64_t size, MemoryType memory_type, uint32_t memory_type_bits)
 {
     return std::make_shared<VKMemory>(*this, size, memory_type, memory_type_bits, nullptr);
@@ -563,16 +665,21 @@ std::shared_ptr<Framebuffer> VKDevice::CreateFramebuffer(const FramebufferDesc&
     return std::make_shared<VKFramebuffer>(*this, desc);
 }
 
-std::shared_ptr<Shader> VKDevice::CreateShader(const std::vector<uint8_t>& blob,
-                                               ShaderBlobType blob_type,
-                                               ShaderType shader_type)
+std::shared_ptr<Shader> VKDevice::CreateShader(const ShaderBlob& blob, ShaderBlobType blob_type, ShaderType shader_type)
 {
-    return std::make_shared<ShaderBase>(blob, blob_type, shader_type);
+    return std::make_shared<VKShader>(*this, blob, blob_type, shader_type);
 }
 
 std::shared_ptr<Shader> VKDevice::CompileShader(const ShaderDesc& desc)
 {
-    return std::make_shared<ShaderBase>(desc, ShaderBlobType::kSPIRV);
+    return std::make_shared<VKShader>(*this, desc, ShaderBlobType::kSPIRV);
+}
+
+std::vector<std::shared_ptr<Shader>> VKDevice::CompileShaders(const std::vector<ShaderDesc>& descs)
+{
+    std::vector<std::shared_ptr<Shader>> shaders(descs.size());
+    GetThreadPool().ParallelFor(descs.size(), [&](size_t i) { shaders[i] = CompileShader(descs[i]); });
+    return shaders;
 }
 
 std::shared_ptr<Program> VKDevice::CreateProgram(const std::vector<std::shared_ptr<Shader>>& shaders)
@@ -582,17 +689,32 @@ std::shared_ptr<Program> VKDevice::CreateProgram(const std::vector<std::shared_p
 
 std::shared_ptr<Pipeline> VKDevice::CreateGraphicsPipeline(const GraphicsPipelineDesc& desc)
 {
-    return std::make_shared<VKGraphicsPipeline>(*this, desc);
+    return m_pipeline_deduplicator.GetOrCreate(desc, [&] {
+        auto start = std::chrono::steady_clock::now();
+        auto pipeline = std::make_shared<VKGraphicsPipeline>(*this, desc);
+        AddPipelineCreationTime(start);
+        return pipeline;
+    });
 }
 
 std::shared_ptr<Pipeline> VKDevice::CreateComputePipeline(const ComputePipelineDesc& desc)
 {
-    return std::make_shared<VKComputePipeline>(*this, desc);
+    return m_pipeline_deduplicator.GetOrCreate(desc, [&] {
+        auto start = std::chrono::steady_clock::now();
+        auto pipeline = std::make_shared<VKComputePipeline>(*this, desc);
+        AddPipelineCreationTime(start);
+        return pipeline;
+    });
 }
 
 std::shared_ptr<Pipeline> VKDevice::CreateRayTracingPipeline(const RayTracingPipelineDesc& desc)
 {
-    return std::make_shared<VKRayTracingPipeline>(*this, desc);
+    return m_pipeline_deduplicator.GetOrCreate(desc, [&] {
+        auto start = std::chrono::steady_clock::now();
+        auto pipeline = std::make_shared<VKRayTracingPipeline>(*this, desc);
+        AddPipelineCreationTime(start);
+        return pipeline;
+    });
 }
 
 vk::AccelerationStructureGeometryKHR VKDevice::FillRaytracingGeometryTriangles(const BufferDesc& vertex,
@@ -706,6 +828,29 @@ bool VKDevice::IsGeometryShaderSupported() const
     return m_geometry_shader_supported;
 }
 
+uint64_t VKDevice::GetTimestampFrequency(CommandListType type) const
+{
+    if (!m_device_properties.limits.timestampComputeAndGraphics) {
+        return 0;
+    }
+    return static_cast<uint64_t>(1e9 / m_device_properties.limits.timestampPeriod);
+}
+
+bool VKDevice::IsFloat16Supported() const
+{
+    return m_is_float16_supported;
+}
+
+bool VKDevice::IsInt16Supported() const
+{
+    return m_is_int16_supported;
+}
+
+bool VKDevice::IsDynamicStateSupported() const
+{
+    return m_is_dynamic_state_supported;
+}
+
 uint32_t VKDevice::GetShadingRateImageTileSize() const
 {
     return m_shading_rate_image_tile_size;
@@ -781,6 +926,29 @@ ShaderBlobType VKDevice::GetSupportedShaderBlobType() const
     return ShaderBlobType::kSPIRV;
 }
 
+bool VKDevice::SavePipelineCache()
+{
+    return m_pipeline_cache->Save();
+}
+
+PipelineCacheStats VKDevice::GetPipelineCacheStats() const
+{
+    PipelineCacheStats stats = {};
+    stats.loaded_size = m_pipeline_cache->GetLoadedSize();
+    stats.pipeline_count = m_pipeline_count;
+    stats.creation_time_us = m_pipeline_creation_time_us;
+    stats.hit_count = m_pipeline_deduplicator.GetHitCount();
+    stats.miss_count = m_pipeline_deduplicator.GetMissCount();
+    return stats;
+}
+
+void VKDevice::AddPipelineCreationTime(std::chrono::steady_clock::time_point start)
+{
+    auto duration = std::chrono::steady_clock::now() - start;
+    ++m_pipeline_count;
+    m_pipeline_creation_time_us += std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
 VKAdapter& VKDevice::GetAdapter()
 {
     return m_adapter;
@@ -791,6 +959,16 @@ vk::Device VKDevice::GetDevice()
     return m_device.get();
 }
 
+vk::PipelineCache VKDevice::GetPipelineCache() const
+{
+    return m_pipeline_cache->GetPipelineCache();
+}
+
+bool VKDevice::IsMaintenance5Supported() const
+{
+    return m_is_maintenance5_supported;
+}
+
 CommandListType VKDevice::GetAvailableCommandListType(CommandListType type)
 {
     if (m_queues_info.count(type)) {
@@ -2,9 +2,15 @@
 #include "Device/Device.h"
 #include "GPUDescriptorPool/VKGPUBindlessDescriptorPoolTyped.h"
 #include "GPUDescriptorPool/VKGPUDescriptorPool.h"
+#include "Pipeline/PipelineDeduplicator.h"
+#include "Pipeline/VKPipelineCache.h"
 
 #include <vulkan/vulkan.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+
 class VKAdapter;
 class VKCommandQueue;
 
@@ -14,6 +20,7 @@ vk::BuildAccelerationStructureFlagsKHR Convert(BuildAccelerationStructureFlags f
 class VKDevice : public Device {
 public:
     VKDevice(VKAdapter& adapter);
+    ~VKDevice();
     std::shared_ptr<Memory> AllocateMemory(uint64_t size, MemoryType memory_type, uint32_t memory_type_bits) override;
     std::shared_ptr<CommandQueue> GetCommandQueue(CommandListType type) override;
     uint32_t GetTextureDataPitchAlignment() const override;
@@ -39,10 +46,11 @@ public:
     std::shared_ptr<BindingSet> CreateBindingSet(const std::shared_ptr<BindingSetLayout>& layout) override;
     std::shared_ptr<RenderPass> CreateRenderPass(const RenderPassDesc& desc) override;
     std::shared_ptr<Framebuffer> CreateFramebuffer(const FramebufferDesc& desc) override;
-    std::shared_ptr<Shader> CreateShader(const std::vector<uint8_t>& blob,
+    std::shared_ptr<Shader> CreateShader(const ShaderBlob& blob,
                                          ShaderBlobType blob_type,
                                          ShaderType shader_type) override;
     std::shared_ptr<Shader> CompileShader(const ShaderDesc& desc) override;
+    std::vector<std::shared_ptr<Shader>> CompileShaders(const std::vector<ShaderDesc>& descs) override;
     std::shared_ptr<Program> CreateProgram(const std::vector<std::shared_ptr<Shader>>& shaders) override;
     std::shared_ptr<Pipeline> CreateGraphicsPipeline(const GraphicsPipelineDesc& desc) override;
     std::shared_ptr<Pipeline> CreateComputePipeline(const ComputePipelineDesc& desc) override;
@@ -57,19 +65,28 @@ public:
     bool IsMeshShadingSupported() const override;
     bool IsDrawIndirectCountSupported() const override;
     bool IsGeometryShaderSupported() const override;
+    bool IsFloat16Supported() const override;
+    bool IsInt16Supported() const override;
+    bool IsDynamicStateSupported() const override;
     uint32_t GetShadingRateImageTileSize() const override;
     MemoryBudget GetMemoryBudget() const override;
     uint32_t GetShaderGroupHandleSize() const override;
     uint32_t GetShaderRecordAlignment() const override;
     uint32_t GetShaderTableAlignment() const override;
+    uint64_t GetTimestampFrequency(CommandListType type) const override;
     RaytracingASPrebuildInfo GetBLASPrebuildInfo(const std::vector<RaytracingGeometryDesc>& descs,
                                                  BuildAccelerationStructureFlags flags) const override;
     RaytracingASPrebuildInfo GetTLASPrebuildInfo(uint32_t instance_count,
                                                  BuildAccelerationStructureFlags flags) const override;
     ShaderBlobType GetSupportedShaderBlobType() const override;
+    bool SavePipelineCache() override;
+    PipelineCacheStats GetPipelineCacheStats() const override;
 
     VKAdapter& GetAdapter();
     vk::Device GetDevice();
+    vk::PipelineCache GetPipelineCache() const;
+    // Shader stages may chain vk::ShaderModuleCreateInfo instead of referencing a shader module
+    bool IsMaintenance5Supported() const;
     CommandListType GetAvailableCommandListType(CommandListType type);
     vk::CommandPool GetCmdPool(CommandListType type);
     vk::ImageAspectFlags GetAspectFlags(vk::Format format) const;
@@ -86,10 +103,15 @@ private:
     RaytracingASPrebuildInfo GetAccelerationStructurePrebuildInfo(
         const vk::AccelerationStructureBuildGeometryInfoKHR& acceleration_structure_info,
         const std::vector<uint32_t>& max_primitive_counts) const;
+    void AddPipelineCreationTime(std::chrono::steady_clock::time_point start);
 
     VKAdapter& m_adapter;
     const vk::PhysicalDevice& m_physical_device;
     vk::UniqueDevice m_device;
+    std::unique_ptr<VKPipelineCache> m_pipeline_cache;
+    std::atomic<uint64_t> m_pipeline_count = 0;
+    std::atomic<uint64_t> m_pipeline_creation_time_us = 0;
+    PipelineDeduplicator m_pipeline_deduplicator;
     struct QueueInfo {
         uint32_t queue_family_index;
         uint32_t queue_count;
@@ -109,5 +131,9 @@ private:
     uint32_t m_shader_table_alignment = 0;
     bool m_draw_indirect_count_supported = false;
     bool m_geometry_shader_supported = false;
+    bool m_is_float16_supported = false;
+    bool m_is_int16_supported = false;
+    bool m_is_maintenance5_supported = false;
+    bool m_is_dynamic_state_supported = false;
     vk::PhysicalDeviceProperties m_device_properties = {};
 };
@@ -1,13 +1,20 @@
 #include "HLSLCompiler/Compiler.h"
 
 #include "HLSLCompiler/DXCLoader.h"
+#include "HLSLCompiler/ShaderCache.h"
+#include "HLSLCompiler/ShaderSourceProvider.h"
 #include "Utilities/DXUtility.h"
+#include "Utilities/Hash.h"
 #include "Utilities/SystemUtils.h"
+#include "Utilities/ThreadPool.h"
 
 #include <nowide/convert.hpp>
 
 #include <cassert>
+#include <cstring>
 #include <deque>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <vector>
 
@@ -36,12 +43,47 @@ std::string GetShaderTarget(ShaderType type, const std::string& model)
     }
 }
 
+std::wstring GetOptimizationArgument(ShaderOptimizationLevel level)
+{
+    switch (level) {
+    case ShaderOptimizationLevel::kDisabled:
+        return L"-Od";
+    case ShaderOptimizationLevel::kLevel0:
+        return L"-O0";
+    case ShaderOptimizationLevel::kLevel1:
+        return L"-O1";
+    case ShaderOptimizationLevel::kLevel2:
+        return L"-O2";
+    case ShaderOptimizationLevel::kLevel3:
+        return L"-O3";
+    default:
+        assert(false);
+        return L"-O3";
+    }
+}
+
+std::wstring GetSPIRVTargetEnvArgument(SPIRVTargetEnv target_env)
+{
+    switch (target_env) {
+    case SPIRVTargetEnv::kVulkan1_1:
+        return L"-fspv-target-env=vulkan1.1";
+    case SPIRVTargetEnv::kVulkan1_2:
+        return L"-fspv-target-env=vulkan1.2";
+    case SPIRVTargetEnv::kVulkan1_3:
+        return L"-fspv-target-env=vulkan1.3";
+    default:
+        assert(false);
+        return L"-fspv-target-env=vulkan1.2";
+    }
+}
+
 } // namespace
 
 class IncludeHandler : public IDxcIncludeHandler {
 public:
-    IncludeHandler(CComPtr<IDxcLibrary> library, const std::wstring& base_path)
+    IncludeHandler(CComPtr<IDxcLibrary> library, ShaderSourceProvider& source_provider, const std::wstring& base_path)
         : m_library(library)
+        , m_source_provider(source_provider)
         , m_base_path(base_path)
     {
     }
@@ -62,31 +104,48 @@ public:
     HRESULT STDMETHODCALLTYPE LoadSource(_In_ LPCWSTR pFilename,
                                          _COM_Outptr_result_maybenull_ IDxcBlob** ppIncludeSource) override
     {
-        std::wstring path = m_base_path + pFilename;
+        std::string path = NormalizeShaderPath(nowide::narrow(m_base_path + pFilename));
+        std::shared_ptr<const ShaderSource> include_source = m_source_provider.Load(path);
+        if (!include_source) {
+            m_dependencies[path] = 0;
+            return E_FAIL;
+        }
+        m_dependencies[path] = include_source->hash;
+
         CComPtr<IDxcBlobEncoding> source;
-        HRESULT hr = m_library->CreateBlobFromFile(path.c_str(), nullptr, &source);
+        HRESULT hr = m_library->CreateBlobWithEncodingOnHeapCopy(
+            include_source->data.data(), static_cast<UINT32>(include_source->data.size()), CP_ACP, &source);
         if (SUCCEEDED(hr) && ppIncludeSource) {
             *ppIncludeSource = source.Detach();
         }
         return hr;
     }
 
+    const ShaderCacheDependencies& GetDependencies() const
+    {
+        return m_dependencies;
+    }
+
 private:
     CComPtr<IDxcLibrary> m_library;
+    ShaderSourceProvider& m_source_provider;
     const std::wstring& m_base_path;
+    ShaderCacheDependencies m_dependencies;
 };
 
-std::vector<uint8_t> Compile(const ShaderDesc& shader, ShaderBlobType blob_type)
+CompileResult CompileWithDiagnostics(const ShaderDesc& shader, ShaderBlobType blob_type)
 {
-    decltype(auto) dxc_support = GetDxcSupport(blob_type);
-
     std::wstring shader_path = nowide::widen(shader.shader_path);
     std::wstring shader_dir = shader_path.substr(0, shader_path.find_last_of(L"\\/") + 1);
 
-    CComPtr<IDxcLibrary> library;
-    dxc_support.CreateInstance(CLSID_DxcLibrary, &library);
-    CComPtr<IDxcBlobEncoding> source;
-    ASSERT_SUCCEEDED(library->CreateBlobFromFile(shader_path.c_str(), nullptr, &source));
+    decltype(auto) source_provider = GetShaderSourceProvider();
+    std::shared_ptr<const ShaderSource> main_source =
+        shader.source.empty() ? source_provider.Load(shader.shader_path) : CreateShaderSource(shader.source);
+    if (!main_source) {
+        CompileResult compile_result = {};
+        compile_result.diagnostics = "Failed to load shader source " + shader.shader_path;
+        return compile_result;
+    }
 
     std::wstring target = nowide::widen(GetShaderTarget(shader.type, shader.model));
     std::wstring entrypoint = nowide::widen(shader.entrypoint);
@@ -97,14 +156,24 @@ std::vector<uint8_t> Compile(const ShaderDesc& shader, ShaderBlobType blob_type)
         defines.push_back({ defines_store.back().first.c_str(), defines_store.back().second.c_str() });
     }
 
+    const ShaderCompileOptions& options = shader.options;
+    bool write_pdb = blob_type == ShaderBlobType::kDXIL && !options.pdb_path.empty();
     std::vector<LPCWSTR> arguments;
     std::deque<std::wstring> dynamic_arguments;
-    arguments.push_back(L"/Zi");
-    arguments.push_back(L"/Qembed_debug");
+    if (!options.strip_debug_info || write_pdb) {
+        arguments.push_back(L"/Zi");
+        arguments.push_back(options.strip_debug_info ? L"/Qstrip_debug" : L"/Qembed_debug");
+    }
+    dynamic_arguments.emplace_back(GetOptimizationArgument(options.optimization_level));
+    arguments.emplace_back(dynamic_arguments.back().c_str());
+    if (options.enable_16bit_types) {
+        arguments.emplace_back(L"-enable-16bit-types");
+    }
     uint32_t space = 0;
     if (blob_type == ShaderBlobType::kSPIRV) {
         arguments.emplace_back(L"-spirv");
-        arguments.emplace_back(L"-fspv-target-env=vulkan1.2");
+        dynamic_arguments.emplace_back(GetSPIRVTargetEnvArgument(options.spirv_target_env));
+        arguments.emplace_back(dynamic_arguments.back().c_str());
         arguments.emplace_back(L"-fspv-extension=KHR");
         arguments.emplace_back(L"-fspv-extension=SPV_EXT_mesh_shader");
         arguments.emplace_back(L"-fspv-extension=SPV_EXT_descriptor_indexing");
@@ -120,29 +189,100 @@ std::vector<uint8_t> Compile(const ShaderDesc& shader, ShaderBlobType blob_type)
     dynamic_arguments.emplace_back(std::to_wstring(space));
     arguments.emplace_back(dynamic_arguments.back().c_str());
 
+    // Includes are not known before compilation, the cache entry records and validates them
+    decltype(auto) cache = GetShaderCache();
+    uint64_t source_hash = main_source->hash;
+    Hasher key;
+    key.Update(GetDxcCompilerStamp())
+        .Update(blob_type)
+        .Update(source_hash)
+        .Update(nowide::narrow(shader_dir))
+        .Update(nowide::narrow(entrypoint))
+        .Update(nowide::narrow(target));
+    for (const auto& define : shader.define) {
+        key.Update(define.first).Update(define.second);
+    }
+    for (const auto& argument : arguments) {
+        key.Update(nowide::narrow(argument));
+    }
+    CompileResult compile_result = {};
+    // The PDB is only produced by an actual compilation
+    auto get_dependency_hash = [&](const std::string& path) -> uint64_t {
+        std::shared_ptr<const ShaderSource> source = source_provider.Load(path);
+        return source ? source->hash : 0;
+    };
+    if (!write_pdb &&
+        cache.Load(key.GetHash(), compile_result.blob, compile_result.dependencies, get_dependency_hash)) {
+        compile_result.dependencies[NormalizeShaderPath(shader.shader_path)] = source_hash;
+        return compile_result;
+    }
+
+    DxcInstancePtr dxc_instance = AcquireDxcInstance(blob_type);
+
+    CComPtr<IDxcBlobEncoding> source;
+    ASSERT_SUCCEEDED(dxc_instance->library->CreateBlobWithEncodingOnHeapCopy(
+        main_source->data.data(), static_cast<UINT32>(main_source->data.size()), CP_ACP, &source));
+
     CComPtr<IDxcOperationResult> result;
-    IncludeHandler include_handler(library, shader_dir);
-    CComPtr<IDxcCompiler> compiler;
-    dxc_support.CreateInstance(CLSID_DxcCompiler, &compiler);
-    ASSERT_SUCCEEDED(compiler->Compile(source, L"main.hlsl", entrypoint.c_str(), target.c_str(), arguments.data(),
-                                       static_cast<UINT32>(arguments.size()), defines.data(),
-                                       static_cast<UINT32>(defines.size()), &include_handler, &result));
+    CComPtr<IDxcBlob> pdb;
+    IncludeHandler include_handler(dxc_instance->library, source_provider, shader_dir);
+    ASSERT_SUCCEEDED(dxc_instance->compiler->CompileWithDebug(
+        source, L"main.hlsl", entrypoint.c_str(), target.c_str(), arguments.data(),
+        static_cast<UINT32>(arguments.size()), defines.data(), static_cast<UINT32>(defines.size()), &include_handler,
+        &result, nullptr, write_pdb ? &pdb : nullptr));
 
     HRESULT hr = {};
     result->GetStatus(&hr);
-    std::vector<uint8_t> blob;
     if (SUCCEEDED(hr)) {
         CComPtr<IDxcBlob> dxc_blob;
         ASSERT_SUCCEEDED(result->GetResult(&dxc_blob));
-        blob.assign((uint8_t*)dxc_blob->GetBufferPointer(),
-                    (uint8_t*)dxc_blob->GetBufferPointer() + dxc_blob->GetBufferSize());
-    } else {
-        CComPtr<IDxcBlobEncoding> errors;
-        result->GetErrorBuffer(&errors);
-        if (errors && errors->GetBufferSize() > 0) {
-            OutputDebugStringA(reinterpret_cast<char*>(errors->GetBufferPointer()));
-            std::cout << reinterpret_cast<char*>(errors->GetBufferPointer()) << std::endl;
+        compile_result.blob.assign((uint8_t*)dxc_blob->GetBufferPointer(),
+                                   (uint8_t*)dxc_blob->GetBufferPointer() + dxc_blob->GetBufferSize());
+        cache.Store(key.GetHash(), include_handler.GetDependencies(), compile_result.blob);
+        if (pdb) {
+            std::ofstream file(std::filesystem::u8path(options.pdb_path), std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(pdb->GetBufferPointer()), pdb->GetBufferSize());
         }
     }
-    return blob;
+    compile_result.dependencies = include_handler.GetDependencies();
+    compile_result.dependencies[NormalizeShaderPath(shader.shader_path)] = source_hash;
+
+    CComPtr<IDxcBlobEncoding> errors;
+    result->GetErrorBuffer(&errors);
+    if (errors && errors->GetBufferSize() > 0) {
+        const char* errors_data = reinterpret_cast<const char*>(errors->GetBufferPointer());
+        compile_result.diagnostics.assign(errors_data, strnlen(errors_data, errors->GetBufferSize()));
+    }
+    return compile_result;
+}
+
+std::vector<uint8_t> Compile(const ShaderDesc& shader, ShaderBlobType blob_type)
+{
+    CompileResult result = CompileWithDiagnostics(shader, blob_type);
+    if (result.blob.empty() && !result.diagnostics.empty()) {
+        OutputDebugStringA(result.diagnostics.c_str());
+        std::cout << result.diagnostics << std::endl;
+    }
+    return std::move(result.blob);
+}
+
+std::vector<CompileResult> CompileBatch(const std::vector<ShaderDesc>& shaders, ShaderBlobType blob_type)
+{
+    std::vector<CompileResult> results(shaders.size());
+    GetThreadPool().ParallelFor(shaders.size(),
+                                [&](size_t i) { results[i] = CompileWithDiagnostics(shaders[i], blob_type); });
+    return results;
+}
+
+std::vector<std::vector<CompileResult>> CompileBatch(const std::vector<ShaderDesc>& shaders,
+                                                     const std::vector<ShaderBlobType>& blob_types)
+{
+    std::vector<std::vector<CompileResult>> results(shaders.size(), std::vector<CompileResult>(blob_types.size()));
+    GetThreadPool().ParallelFor(shaders.size() * blob_types.size(), [&](size_t i) {
+        size_t shader_index = i / blob_types.size();
+        size_t blob_type_index = i % blob_types.size();
+        results[shader_index][blob_type_index] =
+            CompileWithDiagnostics(shaders[shader_index], blob_types[blob_type_index]);
+    });
+    return results;
 }
@@ -1,4 +1,20 @@
 #pragma once
+#include "HLSLCompiler/ShaderCache.h"
 #include "Instance/BaseTypes.h"
 
+#include <string>
+#include <vector>
+
+struct CompileResult {
+    std::vector<uint8_t> blob;
+    std::string diagnostics;
+    // The main source and every include opened by the compiler
+    ShaderCacheDependencies dependencies;
+};
+
+CompileResult CompileWithDiagnostics(const ShaderDesc& shader, ShaderBlobType blob_type);
 std::vector<uint8_t> Compile(const ShaderDesc& shader, ShaderBlobType blob_type);
+std::vector<CompileResult> CompileBatch(const std::vector<ShaderDesc>& shaders, ShaderBlobType blob_type);
+// Results are indexed as [shader][blob type], every pair is compiled as a separate job
+std::vector<std::vector<CompileResult>> CompileBatch(const std::vector<ShaderDesc>& shaders,
+                                                     const std::vector<ShaderBlobType>& blob_types);
@@ -1,11 +1,14 @@
 #include "HLSLCompiler/DXCLoader.h"
 
+#include "Utilities/DXUtility.h"
+#include "Utilities/Hash.h"
 #include "Utilities/ScopeGuard.h"
 #include "Utilities/SystemUtils.h"
 
 #include <dxc/Support/Global.h>
 
 #include <filesystem>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -43,15 +46,28 @@ HRESULT Test(dxc::DxcDllSupport& dll_support, ShaderBlobType target)
     return hr;
 }
 
-std::unique_ptr<dxc::DxcDllSupport> Load(const std::string& path, ShaderBlobType target)
+std::filesystem::path GetDxcompilerPath(const std::string& path)
 {
 #if defined(_WIN32)
-    auto dxcompiler_path = std::filesystem::u8path(path) / "dxcompiler.dll";
+    return std::filesystem::u8path(path) / "dxcompiler.dll";
 #elif defined(__APPLE__)
-    auto dxcompiler_path = std::filesystem::u8path(path) / "libdxcompiler.dylib";
+    return std::filesystem::u8path(path) / "libdxcompiler.dylib";
 #else
-    auto dxcompiler_path = std::filesystem::u8path(path) / "libdxcompiler.so";
+    return std::filesystem::u8path(path) / "libdxcompiler.so";
 #endif
+}
+
+std::vector<std::string> GetDxcLocations()
+{
+    return {
+        GetExecutableDir(),
+        DXC_CUSTOM_LOCATION,
+    };
+}
+
+std::unique_ptr<dxc::DxcDllSupport> Load(const std::string& path, ShaderBlobType target)
+{
+    auto dxcompiler_path = GetDxcompilerPath(path);
     if (!std::filesystem::exists(dxcompiler_path)) {
         return {};
     }
@@ -84,11 +100,7 @@ std::unique_ptr<dxc::DxcDllSupport> Load(const std::string& path, ShaderBlobType
 
 std::unique_ptr<dxc::DxcDllSupport> GetDxcSupportImpl(ShaderBlobType target)
 {
-    std::vector<std::string> localions = {
-        GetExecutableDir(),
-        DXC_CUSTOM_LOCATION,
-    };
-    for (const auto& path : localions) {
+    for (const auto& path : GetDxcLocations()) {
         auto res = Load(path, target);
         if (res) {
             return res;
@@ -102,10 +114,60 @@ std::unique_ptr<dxc::DxcDllSupport> GetDxcSupportImpl(ShaderBlobType target)
 
 dxc::DxcDllSupport& GetDxcSupport(ShaderBlobType target)
 {
+    static std::mutex mutex;
     static std::map<ShaderBlobType, std::unique_ptr<dxc::DxcDllSupport>> cache;
+    std::lock_guard<std::mutex> lock(mutex);
     auto it = cache.find(target);
     if (it == cache.end()) {
         it = cache.emplace(target, GetDxcSupportImpl(target)).first;
     }
     return *it->second;
 }
+
+DxcInstancePtr AcquireDxcInstance(ShaderBlobType target)
+{
+    decltype(auto) dxc_support = GetDxcSupport(target);
+
+    // Declared after the dll cache so that pooled instances are released before the dll is unloaded
+    static std::mutex mutex;
+    static std::map<ShaderBlobType, std::vector<std::unique_ptr<DxcInstance>>> pool;
+
+    auto release = [target](DxcInstance* instance) {
+        std::lock_guard<std::mutex> lock(mutex);
+        pool[target].emplace_back(instance);
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        decltype(auto) free_instances = pool[target];
+        if (!free_instances.empty()) {
+            DxcInstancePtr instance(free_instances.back().release(), release);
+            free_instances.pop_back();
+            return instance;
+        }
+    }
+
+    auto instance = std::make_unique<DxcInstance>();
+    ASSERT_SUCCEEDED(dxc_support.CreateInstance(CLSID_DxcLibrary, &instance->library));
+    ASSERT_SUCCEEDED(dxc_support.CreateInstance(CLSID_DxcCompiler, &instance->compiler));
+    return DxcInstancePtr(instance.release(), release);
+}
+
+uint64_t GetDxcCompilerStamp()
+{
+    static const uint64_t stamp = [] {
+        Hasher hasher;
+        std::error_code ec;
+        for (const auto& path : GetDxcLocations()) {
+            auto dxcompiler_path = GetDxcompilerPath(path);
+            uint64_t size = std::filesystem::file_size(dxcompiler_path, ec);
+            if (ec) {
+                continue;
+            }
+            auto time = std::filesystem::last_write_time(dxcompiler_path, ec).time_since_epoch().count();
+            hasher.Update(dxcompiler_path.u8string()).Update(size).Update(time);
+        }
+        return hasher.GetHash();
+    }();
+    return stamp;
+}
@@ -4,4 +4,19 @@
 #include <dxc/Support/WinIncludes.h>
 #include <dxc/Support/dxcapi.use.h>
 
+#include <functional>
+#include <memory>
+
+struct DxcInstance {
+    CComPtr<IDxcLibrary> library;
+    CComPtr<IDxcCompiler2> compiler;
+};
+
+// Returned to the pool on destruction, an instance is used by a single thread at a time
+using DxcInstancePtr = std::unique_ptr<DxcInstance, std::function<void(DxcInstance*)>>;
+
 dxc::DxcDllSupport& GetDxcSupport(ShaderBlobType type);
+DxcInstancePtr AcquireDxcInstance(ShaderBlobType type);
+
+// Identifies the dxcompiler binaries on disk without loading them
+uint64_t GetDxcCompilerStamp();
@@ -1,9 +1,17 @@
 #include "HLSLCompiler/MSLConverter.h"
 
 #include "HLSLCompiler/Compiler.h"
+#include "HLSLCompiler/ShaderCache.h"
+#include "Utilities/Hash.h"
 
 #include <spirv_msl.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <mutex>
+#include <sstream>
+
 namespace {
 
 std::map<std::string, uint32_t> ParseBindings(const spirv_cross::CompilerMSL& compiler)
@@ -27,6 +35,50 @@ std::map<std::string, uint32_t> ParseBindings(const spirv_cross::CompilerMSL& co
     return mapping;
 }
 
+// Bump when the conversion changes in a way that is not covered by the options hash, including spirv-cross updates
+constexpr uint32_t kMSLCacheVersion = 2;
+constexpr const char* kMSLHeader = "// FlyCube MSL:";
+// Older conversions are dropped from memory first, they are still found in the shader cache
+constexpr size_t kMaxMSLShadersInMemory = 256;
+
+spirv_cross::CompilerMSL::Options GetMSLOptions()
+{
+    spirv_cross::CompilerMSL::Options options;
+    options.set_msl_version(2, 3);
+    options.argument_buffers = UseArgumentBuffers();
+    options.force_active_argument_buffer_resources = options.argument_buffers;
+    options.argument_buffers_tier = spirv_cross::CompilerMSL::Options::ArgumentBuffersTier::Tier2;
+    return options;
+}
+
+uint64_t GetMSLCacheKey(const void* data, size_t size)
+{
+    auto options = GetMSLOptions();
+    Hasher hasher;
+    hasher.Update(kMSLCacheVersion);
+    hasher.Update(options.platform);
+    hasher.Update(options.msl_version);
+    hasher.Update(options.argument_buffers);
+    hasher.Update(options.force_active_argument_buffer_resources);
+    hasher.Update(options.argument_buffers_tier);
+    hasher.Update(data, size);
+    return hasher.GetHash();
+}
+
+struct MSLShader {
+    std::string source;
+    std::map<std::string, uint32_t> mapping;
+};
+
+void ConvertToMSL(const void* data, size_t size, MSLShader& msl_shader)
+{
+    assert(size % sizeof(uint32_t) == 0);
+    spirv_cross::CompilerMSL compiler(static_cast<const uint32_t*>(data), size / sizeof(uint32_t));
+    compiler.set_msl_options(GetMSLOptions());
+    msl_shader.source = compiler.compile();
+    msl_shader.mapping = ParseBindings(compiler);
+}
+
 } // namespace
 
 bool UseArgumentBuffers()
@@ -34,23 +86,110 @@ bool UseArgumentBuffers()
     return false;
 }
 
-std::string GetMSLShader(const std::vector<uint8_t>& blob, std::map<std::string, uint32_t>& mapping)
+std::string GetMSLShader(const void* data, size_t size, std::map<std::string, uint32_t>& mapping)
 {
-    assert(blob.size() % sizeof(uint32_t) == 0);
-    spirv_cross::CompilerMSL compiler((const uint32_t*)blob.data(), blob.size() / sizeof(uint32_t));
-    auto options = compiler.get_msl_options();
-    options.set_msl_version(2, 3);
-    options.argument_buffers = UseArgumentBuffers();
-    options.force_active_argument_buffer_resources = options.argument_buffers;
-    options.argument_buffers_tier = spirv_cross::CompilerMSL::Options::ArgumentBuffersTier::Tier2;
-    compiler.set_msl_options(options);
-    auto msl_source = compiler.compile();
-    mapping = ParseBindings(compiler);
-    return msl_source;
+    // Recent conversions are kept in memory and all of them in the shader cache across runs
+    static std::mutex mutex;
+    static std::map<uint64_t, std::shared_ptr<const MSLShader>> msl_shaders;
+    static std::deque<uint64_t> msl_shader_keys;
+
+    uint64_t key = GetMSLCacheKey(data, size);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = msl_shaders.find(key);
+        if (it != msl_shaders.end()) {
+            mapping = it->second->mapping;
+            return it->second->source;
+        }
+    }
+
+    auto msl_shader = std::make_shared<MSLShader>();
+    std::vector<uint8_t> record;
+    ShaderCacheDependencies dependencies;
+    decltype(auto) cache = GetShaderCache();
+    if (!cache.Load(key, record, dependencies) ||
+        !ParseMSLShader(record.data(), record.size(), data, size, msl_shader->source, msl_shader->mapping)) {
+        ConvertToMSL(data, size, *msl_shader);
+        std::string serialized = SerializeMSLShader(msl_shader->source, msl_shader->mapping, data, size);
+        cache.Store(key, {}, std::vector<uint8_t>(serialized.begin(), serialized.end()));
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (msl_shaders.emplace(key, msl_shader).second) {
+        msl_shader_keys.push_back(key);
+        if (msl_shader_keys.size() > kMaxMSLShadersInMemory) {
+            msl_shaders.erase(msl_shader_keys.front());
+            msl_shader_keys.pop_front();
+        }
+    }
+    mapping = msl_shader->mapping;
+    return msl_shader->source;
 }
 
 std::string GetMSLShader(const ShaderDesc& shader, std::map<std::string, uint32_t>& mapping)
 {
     std::vector<uint8_t> blob = Compile(shader, ShaderBlobType::kSPIRV);
-    return GetMSLShader(blob, mapping);
+    return GetMSLShader(blob.data(), blob.size(), mapping);
+}
+
+std::string SerializeMSLShader(const std::string& source,
+                               const std::map<std::string, uint32_t>& mapping,
+                               const void* spirv,
+                               size_t spirv_size)
+{
+    std::ostringstream stream;
+    stream << kMSLHeader << " " << HashBytes(spirv, spirv_size) << " " << mapping.size() << "\n";
+    for (const auto& [name, index] : mapping) {
+        stream << "// " << name << " " << index << "\n";
+    }
+    stream << source;
+    return stream.str();
+}
+
+bool ParseMSLShader(const void* data,
+                    size_t size,
+                    const void* spirv,
+                    size_t spirv_size,
+                    std::string& source,
+                    std::map<std::string, uint32_t>& mapping)
+{
+    std::string text(static_cast<const char*>(data), size);
+    size_t pos = 0;
+    auto get_line = [&](std::string& line) {
+        if (pos >= text.size()) {
+            return false;
+        }
+        size_t end = std::min(text.find('\n', pos), text.size());
+        line = text.substr(pos, end - pos);
+        pos = end + 1;
+        return true;
+    };
+
+    std::string line;
+    std::istringstream header_stream(get_line(line) ? line : std::string());
+    std::string header;
+    uint64_t spirv_hash = 0;
+    size_t count = 0;
+    if (!std::getline(header_stream, header, ':') || header + ":" != kMSLHeader ||
+        !(header_stream >> spirv_hash >> count) || spirv_hash != HashBytes(spirv, spirv_size)) {
+        return false;
+    }
+
+    std::map<std::string, uint32_t> bindings;
+    for (size_t i = 0; i < count; ++i) {
+        std::string comment;
+        std::string name;
+        uint32_t index = 0;
+        if (!get_line(line)) {
+            return false;
+        }
+        std::istringstream line_stream(line);
+        if (!(line_stream >> comment >> name >> index) || comment != "//") {
+            return false;
+        }
+        bindings[name] = index;
+    }
+    source = pos < text.size() ? text.substr(pos) : std::string();
+    mapping = std::move(bindings);
+    return true;
 }
@@ -1,6 +1,23 @@
 #pragma once
 #include "Instance/BaseTypes.h"
 
+// Appended to the shader name for the file written by SerializeMSLShader next to the SPIR-V blob
+constexpr const char* kMSLExtension = ".msl";
+
 bool UseArgumentBuffers();
-std::string GetMSLShader(const std::vector<uint8_t>& blob, std::map<std::string, uint32_t>& mapping);
+// Conversions are cached by SPIR-V content and MSL options, in memory and in the shader cache
+std::string GetMSLShader(const void* data, size_t size, std::map<std::string, uint32_t>& mapping);
 std::string GetMSLShader(const ShaderDesc& shader, std::map<std::string, uint32_t>& mapping);
+
+// The MSL source prefixed with comment lines holding a hash of the SPIR-V and the binding slot mapping, still valid MSL
+std::string SerializeMSLShader(const std::string& source,
+                               const std::map<std::string, uint32_t>& mapping,
+                               const void* spirv,
+                               size_t spirv_size);
+// Returns false if the record is malformed or was converted from another SPIR-V
+bool ParseMSLShader(const void* data,
+                    size_t size,
+                    const void* spirv,
+                    size_t spirv_size,
+                    std::string& source,
+                    std::map<std::string, uint32_t>& mapping);
@@ -0,0 +1,275 @@
+#include "HLSLCompiler/ShaderCache.h"
+
+#include "Utilities/Hash.h"
+#include "Utilities/SystemUtils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <tuple>
+
+namespace {
+
+constexpr uint32_t kMagic = 0x43534346; // FCSC
+constexpr uint32_t kVersion = 1;
+constexpr uint64_t kDefaultMaxSize = 256ull << 20;
+constexpr const char* kEntryExtension = ".bin";
+
+template <typename T>
+bool Read(std::istream& stream, T& value)
+{
+    return !!stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+template <typename T>
+void Write(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+std::string GetTempSuffix()
+{
+    static std::atomic<uint64_t> counter = 0;
+    static const uint64_t seed = std::random_device()();
+    return ".tmp" + std::to_string(seed) + "_" + std::to_string(counter++);
+}
+
+// The cache directory may be shared with other files, only entries are ever counted or removed
+bool IsCacheEntry(const std::filesystem::directory_entry& entry)
+{
+    std::error_code ec;
+    return entry.is_regular_file(ec) && entry.path().extension() == kEntryExtension;
+}
+
+uint64_t GetEntriesSize(const std::string& dir)
+{
+    uint64_t total_size = 0;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::u8path(dir), ec)) {
+        if (IsCacheEntry(entry)) {
+            uint64_t size = entry.file_size(ec);
+            total_size += ec ? 0 : size;
+        }
+    }
+    return total_size;
+}
+
+} // namespace
+
+ShaderCache::ShaderCache(const std::string& dir, uint64_t max_size)
+    : m_dir(dir)
+    , m_max_size(max_size)
+{
+}
+
+bool ShaderCache::IsEnabled() const
+{
+    return !m_dir.empty() && m_max_size > 0;
+}
+
+bool ShaderCache::Load(uint64_t key,
+                       std::vector<uint8_t>& blob,
+                       ShaderCacheDependencies& dependencies,
+                       const std::function<uint64_t(const std::string&)>& get_hash)
+{
+    if (!IsEnabled()) {
+        return false;
+    }
+
+    auto path = std::filesystem::u8path(GetEntryPath(key));
+    std::ifstream file(path, std::ios::binary);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t dependency_count = 0;
+    if (!Read(file, magic) || magic != kMagic || !Read(file, version) || version != kVersion ||
+        !Read(file, dependency_count)) {
+        ++m_miss_count;
+        return false;
+    }
+
+    ShaderCacheDependencies entry_dependencies;
+    for (uint32_t i = 0; i < dependency_count; ++i) {
+        uint32_t path_size = 0;
+        uint64_t hash = 0;
+        std::string dependency;
+        if (!Read(file, path_size)) {
+            ++m_miss_count;
+            return false;
+        }
+        dependency.resize(path_size);
+        if (!file.read(dependency.data(), path_size) || !Read(file, hash) ||
+            (get_hash ? get_hash(dependency) : HashFile(dependency)) != hash) {
+            ++m_miss_count;
+            return false;
+        }
+        entry_dependencies.emplace(std::move(dependency), hash);
+    }
+
+    uint64_t blob_size = 0;
+    if (!Read(file, blob_size)) {
+        ++m_miss_count;
+        return false;
+    }
+    std::vector<uint8_t> data(blob_size);
+    if (!file.read(reinterpret_cast<char*>(data.data()), blob_size)) {
+        ++m_miss_count;
+        return false;
+    }
+    file.close();
+
+    std::error_code ec;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+    blob = std::move(data);
+    dependencies = std::move(entry_dependencies);
+    ++m_hit_count;
+    return true;
+}
+
+void ShaderCache::Store(uint64_t key, const ShaderCacheDependencies& dependencies, const std::vector<uint8_t>& blob)
+{
+    if (!IsEnabled() || blob.empty()) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::u8path(m_dir), ec);
+
+    auto path = std::filesystem::u8path(GetEntryPath(key));
+    auto temp_path = std::filesystem::u8path(GetEntryPath(key) + GetTempSuffix());
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        Write(file, kMagic);
+        Write(file, kVersion);
+        Write(file, static_cast<uint32_t>(dependencies.size()));
+        for (const auto& [dependency, hash] : dependencies) {
+            Write(file, static_cast<uint32_t>(dependency.size()));
+            file.write(dependency.data(), dependency.size());
+            Write(file, hash);
+        }
+        Write(file, static_cast<uint64_t>(blob.size()));
+        file.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+        file.close();
+        if (!file) {
+            std::filesystem::remove(temp_path, ec);
+            return;
+        }
+    }
+
+    // Readers only ever observe a complete entry, possibly written by another process
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        return;
+    }
+
+    // Overwritten entries and other processes make the total an estimate, Evict rescans before removing anything
+    std::call_once(m_size_once, [&] { m_size = GetEntriesSize(m_dir); });
+    uint64_t entry_size = std::filesystem::file_size(path, ec);
+    if (!ec && m_size.fetch_add(entry_size) + entry_size > m_max_size) {
+        Evict();
+    }
+}
+
+void ShaderCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_evict_mutex);
+    std::error_code ec;
+    std::vector<std::filesystem::path> entries;
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::u8path(m_dir), ec)) {
+        if (IsCacheEntry(entry)) {
+            entries.push_back(entry.path());
+        }
+    }
+    for (const auto& path : entries) {
+        std::filesystem::remove(path, ec);
+    }
+    m_size = 0;
+}
+
+uint64_t ShaderCache::GetHitCount() const
+{
+    return m_hit_count;
+}
+
+uint64_t ShaderCache::GetMissCount() const
+{
+    return m_miss_count;
+}
+
+uint64_t ShaderCache::HashFile(const std::string& path)
+{
+    std::ifstream file(std::filesystem::u8path(path), std::ios::binary);
+    if (!file) {
+        return 0;
+    }
+
+    Hasher hasher;
+    char buffer[4096];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+        hasher.Update(buffer, file.gcount());
+    }
+    return hasher.GetHash();
+}
+
+std::string ShaderCache::GetEntryPath(uint64_t key) const
+{
+    char name[17] = {};
+    snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return m_dir + "/" + name + kEntryExtension;
+}
+
+void ShaderCache::Evict()
+{
+    std::lock_guard<std::mutex> lock(m_evict_mutex);
+    std::vector<std::tuple<std::filesystem::file_time_type, uint64_t, std::filesystem::path>> entries;
+    uint64_t total_size = 0;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(std::filesystem::u8path(m_dir), ec)) {
+        if (!IsCacheEntry(entry)) {
+            continue;
+        }
+        uint64_t size = entry.file_size(ec);
+        if (ec) {
+            continue;
+        }
+        entries.emplace_back(entry.last_write_time(ec), size, entry.path());
+        total_size += size;
+    }
+    if (total_size <= m_max_size) {
+        m_size = total_size;
+        return;
+    }
+
+    // Leaves some headroom so that the next stores don't immediately trigger another scan
+    uint64_t target_size = m_max_size - m_max_size / 4;
+    std::sort(entries.begin(), entries.end());
+    for (const auto& [time, size, path] : entries) {
+        if (total_size <= target_size) {
+            break;
+        }
+        if (std::filesystem::remove(path, ec)) {
+            total_size -= size;
+        }
+    }
+    m_size = total_size;
+}
+
+ShaderCache& GetShaderCache()
+{
+    static ShaderCache cache = [] {
+        std::string dir = GetEnvironmentVar("FLYCUBE_SHADER_CACHE_DIR");
+        if (dir.empty()) {
+            dir = GetExecutableDir() + "/ShaderCache";
+        }
+        uint64_t max_size = kDefaultMaxSize;
+        std::string size = GetEnvironmentVar("FLYCUBE_SHADER_CACHE_SIZE");
+        if (!size.empty()) {
+            max_size = std::strtoull(size.c_str(), nullptr, 10) << 20;
+        }
+        return ShaderCache(dir, max_size);
+    }();
+    return cache;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Files read by the compiler while producing a blob, mapped to their content hash.
+// A missing file is recorded with a zero hash so that creating it later invalidates the entry.
+using ShaderCacheDependencies = std::map<std::string, uint64_t>;
+
+class ShaderCache {
+public:
+    ShaderCache(const std::string& dir, uint64_t max_size);
+
+    bool IsEnabled() const;
+    // Dependencies are validated with get_hash, HashFile is used by default
+    bool Load(uint64_t key,
+              std::vector<uint8_t>& blob,
+              ShaderCacheDependencies& dependencies,
+              const std::function<uint64_t(const std::string&)>& get_hash = {});
+    void Store(uint64_t key, const ShaderCacheDependencies& dependencies, const std::vector<uint8_t>& blob);
+    void Clear();
+
+    uint64_t GetHitCount() const;
+    uint64_t GetMissCount() const;
+
+    static uint64_t HashFile(const std::string& path);
+
+private:
+    std::string GetEntryPath(uint64_t key) const;
+    void Evict();
+
+    std::string m_dir;
+    uint64_t m_max_size;
+    // Running total of the entries, the directory is only scanned again once it exceeds m_max_size
+    std::atomic<uint64_t> m_size = 0;
+    std::once_flag m_size_once;
+    std::mutex m_evict_mutex;
+    std::atomic<uint64_t> m_hit_count = 0;
+    std::atomic<uint64_t> m_miss_count = 0;
+};
+
+// Configured by FLYCUBE_SHADER_CACHE_DIR and FLYCUBE_SHADER_CACHE_SIZE (in MiB, 0 disables the cache)
+ShaderCache& GetShaderCache();
@@ -0,0 +1,87 @@
+#include "HLSLCompiler/ShaderSourceProvider.h"
+
+#include "Utilities/Hash.h"
+
+#include <fstream>
+#include <iterator>
+
+std::shared_ptr<const ShaderSource> DiskShaderSourceProvider::Load(const std::string& path)
+{
+    std::string normalized_path = NormalizeShaderPath(path);
+    std::error_code ec;
+    auto write_time = std::filesystem::last_write_time(std::filesystem::u8path(normalized_path), ec);
+    if (ec) {
+        return {};
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_files.find(normalized_path);
+        if (it != m_files.end() && it->second.write_time == write_time) {
+            return it->second.source;
+        }
+    }
+
+    std::ifstream file(std::filesystem::u8path(normalized_path), std::ios::binary);
+    if (!file) {
+        return {};
+    }
+    std::string data(std::istreambuf_iterator<char>(file), (std::istreambuf_iterator<char>()));
+    auto source = CreateShaderSource(data);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files[normalized_path] = { write_time, source };
+    return source;
+}
+
+MemoryShaderSourceProvider::MemoryShaderSourceProvider(std::shared_ptr<ShaderSourceProvider> fallback)
+    : m_fallback(fallback)
+{
+}
+
+void MemoryShaderSourceProvider::AddFile(const std::string& path, const std::string& data)
+{
+    auto source = CreateShaderSource(data);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files[NormalizeShaderPath(path)] = source;
+}
+
+void MemoryShaderSourceProvider::RemoveFile(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_files.erase(NormalizeShaderPath(path));
+}
+
+std::shared_ptr<const ShaderSource> MemoryShaderSourceProvider::Load(const std::string& path)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_files.find(NormalizeShaderPath(path));
+        if (it != m_files.end()) {
+            return it->second;
+        }
+    }
+    if (m_fallback) {
+        return m_fallback->Load(path);
+    }
+    return {};
+}
+
+std::string NormalizeShaderPath(const std::string& path)
+{
+    return std::filesystem::u8path(path).lexically_normal().u8string();
+}
+
+std::shared_ptr<const ShaderSource> CreateShaderSource(const std::string& data)
+{
+    auto source = std::make_shared<ShaderSource>();
+    source->data = data;
+    source->hash = HashBytes(data.data(), data.size());
+    return source;
+}
+
+MemoryShaderSourceProvider& GetShaderSourceProvider()
+{
+    static MemoryShaderSourceProvider provider(std::make_shared<DiskShaderSourceProvider>());
+    return provider;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+struct ShaderSource {
+    std::string data;
+    uint64_t hash = 0;
+};
+
+// Resolves the main shader source and its includes, paths are normalized before lookup
+class ShaderSourceProvider {
+public:
+    virtual ~ShaderSourceProvider() = default;
+    virtual std::shared_ptr<const ShaderSource> Load(const std::string& path) = 0;
+};
+
+// Keeps file contents in memory, an entry is reloaded when the file modification time changes
+class DiskShaderSourceProvider : public ShaderSourceProvider {
+public:
+    std::shared_ptr<const ShaderSource> Load(const std::string& path) override;
+
+private:
+    struct Entry {
+        std::filesystem::file_time_type write_time;
+        std::shared_ptr<const ShaderSource> source;
+    };
+
+    std::mutex m_mutex;
+    std::map<std::string, Entry> m_files;
+};
+
+class MemoryShaderSourceProvider : public ShaderSourceProvider {
+public:
+    explicit MemoryShaderSourceProvider(std::shared_ptr<ShaderSourceProvider> fallback = {});
+
+    void AddFile(const std::string& path, const std::string& data);
+    void RemoveFile(const std::string& path);
+    std::shared_ptr<const ShaderSource> Load(const std::string& path) override;
+
+private:
+    std::shared_ptr<ShaderSourceProvider> m_fallback;
+    std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<const ShaderSource>> m_files;
+};
+
+std::string NormalizeShaderPath(const std::string& path);
+std::shared_ptr<const ShaderSource> CreateShaderSource(const std::string& data);
+
+// In-memory files registered by the application, backed by the file system
+MemoryShaderSourceProvider& GetShaderSourceProvider();
@@ -1,8 +1,16 @@
 #include "HLSLCompiler/Compiler.h"
 #include "HLSLCompiler/MSLConverter.h"
+#include "HLSLCompiler/ShaderCache.h"
+#include "HLSLCompiler/ShaderSourceProvider.h"
+#include "Shader/ShaderArchive.h"
+#include "Utilities/MappedFile.h"
 
 #include <catch2/catch_all.hpp>
 
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
 void RunTest(const ShaderDesc& desc)
 {
     auto dxil_blob = Compile(desc, ShaderBlobType::kDXIL);
@@ -13,7 +21,7 @@ void RunTest(const ShaderDesc& desc)
 
     if (desc.type != ShaderType::kLibrary) {
         std::map<std::string, uint32_t> mapping;
-        auto source = GetMSLShader(spirv_blob, mapping);
+        auto source = GetMSLShader(spirv_blob.data(), spirv_blob.size(), mapping);
         REQUIRE(!source.empty());
     }
 }
@@ -52,3 +60,123 @@ TEST_CASE("MeshTrianglePS")
 {
     RunTest({ ASSETS_PATH "shaders/MeshTriangle/PixelShader.hlsl", "main", ShaderType::kPixel, "6_5" });
 }
+
+TEST_CASE("ShaderCache")
+{
+    decltype(auto) cache = GetShaderCache();
+    if (!cache.IsEnabled()) {
+        return;
+    }
+
+    ShaderDesc desc = { ASSETS_PATH "shaders/Triangle/PixelShader.hlsl", "main", ShaderType::kPixel, "6_3" };
+    for (auto blob_type : { ShaderBlobType::kDXIL, ShaderBlobType::kSPIRV }) {
+        auto blob = Compile(desc, blob_type);
+        REQUIRE(!blob.empty());
+        uint64_t hit_count = cache.GetHitCount();
+        auto cached_blob = Compile(desc, blob_type);
+        REQUIRE(cache.GetHitCount() == hit_count + 1);
+        REQUIRE(cached_blob == blob);
+    }
+}
+
+TEST_CASE("CompileBatch")
+{
+    std::vector<ShaderDesc> descs = {
+        { ASSETS_PATH "shaders/Triangle/VertexShader.hlsl", "main", ShaderType::kVertex, "6_3" },
+        { ASSETS_PATH "shaders/Triangle/PixelShader.hlsl", "main", ShaderType::kPixel, "6_3" },
+        { ASSETS_PATH "shaders/MeshTriangle/MeshShader.hlsl", "main", ShaderType::kMesh, "6_5" },
+        { ASSETS_PATH "shaders/MeshTriangle/PixelShader.hlsl", "main", ShaderType::kPixel, "6_5" },
+    };
+    auto results = CompileBatch(descs, { ShaderBlobType::kDXIL, ShaderBlobType::kSPIRV });
+    REQUIRE(results.size() == descs.size());
+    for (const auto& result : results) {
+        REQUIRE(result.size() == 2);
+        REQUIRE(!result[0].blob.empty());
+        REQUIRE(!result[1].blob.empty());
+    }
+}
+
+TEST_CASE("StripDebugInfo")
+{
+    ShaderDesc desc = { ASSETS_PATH "shaders/Triangle/PixelShader.hlsl", "main", ShaderType::kPixel, "6_3" };
+    ShaderDesc stripped_desc = desc;
+    stripped_desc.options.strip_debug_info = true;
+    stripped_desc.options.spirv_target_env = SPIRVTargetEnv::kVulkan1_3;
+    for (auto blob_type : { ShaderBlobType::kDXIL, ShaderBlobType::kSPIRV }) {
+        auto blob = Compile(desc, blob_type);
+        auto stripped_blob = Compile(stripped_desc, blob_type);
+        REQUIRE(!stripped_blob.empty());
+        REQUIRE(stripped_blob.size() < blob.size());
+    }
+}
+
+TEST_CASE("InMemorySource")
+{
+    GetShaderSourceProvider().AddFile("memory/Color.hlsli", "static const float4 kColor = float4(1, 0, 0, 1);");
+    ShaderDesc desc = { "memory/PixelShader.hlsl", "main", ShaderType::kPixel, "6_3" };
+    desc.source = "#include \"Color.hlsli\"\nfloat4 main() : SV_TARGET { return kColor; }";
+    for (auto blob_type : { ShaderBlobType::kDXIL, ShaderBlobType::kSPIRV }) {
+        auto result = CompileWithDiagnostics(desc, blob_type);
+        REQUIRE(!result.blob.empty());
+        REQUIRE(result.dependencies.count("memory/Color.hlsli"));
+    }
+    GetShaderSourceProvider().RemoveFile("memory/Color.hlsli");
+}
+
+TEST_CASE("ShaderArchive")
+{
+    ShaderDesc desc = { ASSETS_PATH "shaders/Triangle/PixelShader.hlsl", "main", ShaderType::kPixel, "6_3" };
+    auto dxil_blob = Compile(desc, ShaderBlobType::kDXIL);
+    auto spirv_blob = Compile(desc, ShaderBlobType::kSPIRV);
+    REQUIRE(!dxil_blob.empty());
+    REQUIRE(!spirv_blob.empty());
+
+    std::string path = (std::filesystem::temp_directory_path() / "FlyCubeShaderArchiveTest.fcsa").u8string();
+    REQUIRE(WriteShaderArchive(path, { { "Triangle/PixelShader.hlsl", ShaderBlobType::kDXIL, dxil_blob },
+                                       { "Triangle/PixelShader.hlsl", ShaderBlobType::kSPIRV, spirv_blob } }));
+
+    auto file = std::make_shared<MappedFile>(path);
+    REQUIRE(file->IsValid());
+    ShaderArchive archive(ShaderBlob(file->GetData(), file->GetSize(), file));
+    REQUIRE(archive.GetEntryCount() == 2);
+    ShaderBlob dxil_entry = archive.GetBlob("Triangle/PixelShader.hlsl", ShaderBlobType::kDXIL);
+    ShaderBlob spirv_entry = archive.GetBlob("Triangle/PixelShader.hlsl", ShaderBlobType::kSPIRV);
+    REQUIRE(std::equal(dxil_entry.begin(), dxil_entry.end(), dxil_blob.begin(), dxil_blob.end()));
+    REQUIRE(std::equal(spirv_entry.begin(), spirv_entry.end(), spirv_blob.begin(), spirv_blob.end()));
+    REQUIRE(reinterpret_cast<uintptr_t>(spirv_entry.data()) % kShaderArchiveBlobAlignment == 0);
+    REQUIRE(archive.GetBlob("Triangle/VertexShader.hlsl", ShaderBlobType::kDXIL).empty());
+
+    std::vector<uint8_t> corrupted(file->GetData(), file->GetData() + file->GetSize());
+    uint32_t bad_bucket = 2;
+    std::memcpy(corrupted.data() + sizeof(ShaderArchiveHeader), &bad_bucket, sizeof(bad_bucket));
+    REQUIRE(!ShaderArchive(ShaderBlob(std::move(corrupted))).IsValid());
+}
+
+TEST_CASE("MSLCache")
+{
+    ShaderDesc desc = { ASSETS_PATH "shaders/Triangle/PixelShader.hlsl", "main", ShaderType::kPixel, "6_3" };
+    auto spirv_blob = Compile(desc, ShaderBlobType::kSPIRV);
+    REQUIRE(!spirv_blob.empty());
+
+    std::map<std::string, uint32_t> mapping;
+    std::string source = GetMSLShader(spirv_blob.data(), spirv_blob.size(), mapping);
+    REQUIRE(!source.empty());
+    std::map<std::string, uint32_t> cached_mapping;
+    REQUIRE(GetMSLShader(spirv_blob.data(), spirv_blob.size(), cached_mapping) == source);
+    REQUIRE(cached_mapping == mapping);
+
+    std::string record = SerializeMSLShader(source, mapping, spirv_blob.data(), spirv_blob.size());
+    std::string parsed_source;
+    std::map<std::string, uint32_t> parsed_mapping;
+    REQUIRE(ParseMSLShader(record.data(), record.size(), spirv_blob.data(), spirv_blob.size(), parsed_source,
+                           parsed_mapping));
+    REQUIRE(parsed_source == source);
+    REQUIRE(parsed_mapping == mapping);
+    REQUIRE(!ParseMSLShader(source.data(), source.size(), spirv_blob.data(), spirv_blob.size(), parsed_source,
+                            parsed_mapping));
+
+    std::vector<uint8_t> rebuilt_blob = spirv_blob;
+    rebuilt_blob.back() ^= 1;
+    REQUIRE(!ParseMSLShader(record.data(), record.size(), rebuilt_blob.data(), rebuilt_blob.size(), parsed_source,
+                            parsed_mapping));
+}
@@ -138,6 +138,12 @@ enum class CullMode {
     kBack,
 };
 
+// Pipelines are created for triangle topologies, the topologies below can be switched between without a new pipeline
+enum class PrimitiveTopology {
+    kTriangleList,
+    kTriangleStrip,
+};
+
 struct RasterizerDesc {
     FillMode fill_mode = FillMode::kSolid;
     CullMode cull_mode = CullMode::kNone;
@@ -241,12 +247,44 @@ struct ViewDesc {
     }
 };
 
+enum class ShaderOptimizationLevel {
+    kDisabled,
+    kLevel0,
+    kLevel1,
+    kLevel2,
+    kLevel3,
+};
+
+enum class SPIRVTargetEnv {
+    kVulkan1_1,
+    kVulkan1_2,
+    kVulkan1_3,
+};
+
+struct ShaderCompileOptions {
+    ShaderOptimizationLevel optimization_level = ShaderOptimizationLevel::kLevel3;
+    bool strip_debug_info = false;
+    // DXIL only, debug info is written to this file in addition to or instead of being embedded
+    std::string pdb_path;
+    SPIRVTargetEnv spirv_target_env = SPIRVTargetEnv::kVulkan1_2;
+    // Makes half, int16_t and uint16_t real 16-bit types, requires shader model 6.2 or higher
+    bool enable_16bit_types = false;
+
+    auto MakeTie() const
+    {
+        return std::tie(optimization_level, strip_debug_info, pdb_path, spirv_target_env, enable_16bit_types);
+    }
+};
+
 struct ShaderDesc {
     std::string shader_path;
     std::string entrypoint;
     ShaderType type;
     std::string model;
     std::map<std::string, std::string> define;
+    ShaderCompileOptions options;
+    // When set, compiled instead of the contents of shader_path, which still anchors relative includes
+    std::string source;
 
     ShaderDesc() = default;
 
@@ -332,6 +370,18 @@ struct FramebufferDesc {
     }
 };
 
+// Overrides the [[vk::constant_id(id)]] constant with the bits of value, only Vulkan and Metal pipelines use them.
+// 16-bit constants take the low bits of value
+struct SpecializationConstant {
+    uint32_t id;
+    uint32_t value;
+
+    auto MakeTie() const
+    {
+        return std::tie(id, value);
+    }
+};
+
 struct GraphicsPipelineDesc {
     std::shared_ptr<Program> program;
     std::shared_ptr<BindingSetLayout> layout;
@@ -340,20 +390,26 @@ struct GraphicsPipelineDesc {
     DepthStencilDesc depth_stencil_desc;
     BlendDesc blend_desc;
     RasterizerDesc rasterizer_desc;
+    std::vector<SpecializationConstant> specialization_constants;
+    // Rasterizer and depth-stencil states and the topology are set on the command list instead,
+    // depth_stencil_desc and rasterizer_desc are ignored. Requires Device::IsDynamicStateSupported
+    bool dynamic_state = false;
 
     auto MakeTie() const
     {
-        return std::tie(program, layout, input, render_pass, depth_stencil_desc, blend_desc, rasterizer_desc);
+        return std::tie(program, layout, input, render_pass, depth_stencil_desc, blend_desc, rasterizer_desc,
+                        specialization_constants, dynamic_state);
     }
 };
 
 struct ComputePipelineDesc {
     std::shared_ptr<Program> program;
     std::shared_ptr<BindingSetLayout> layout;
+    std::vector<SpecializationConstant> specialization_constants;
 
     auto MakeTie() const
     {
-        return std::tie(program, layout);
+        return std::tie(program, layout, specialization_constants);
     }
 };
 
@@ -380,10 +436,11 @@ struct RayTracingPipelineDesc {
     std::shared_ptr<Program> program;
     std::shared_ptr<BindingSetLayout> layout;
     std::vector<RayTracingShaderGroup> groups;
+    std::vector<SpecializationConstant> specialization_constants;
 
     auto MakeTie() const
     {
-        return std::tie(program, layout, groups);
+        return std::tie(program, layout, groups, specialization_constants);
     }
 };
 
@@ -451,6 +508,9 @@ struct ResourceBindingDesc {
     ViewDimension dimension;
     ReturnType return_type;
     uint32_t structure_stride;
+    // Set for [[vk::push_constant]] blocks and DXIL constant buffers in kRootConstantsSpace,
+    // count is the number of 32-bit values then
+    bool is_root_constant;
 };
 
 enum class PipelineType {
@@ -627,7 +687,11 @@ using IndirectCountType = uint32_t;
 
 constexpr uint64_t kAccelerationStructureAlignment = 256;
 
-enum class QueryHeapType { kAccelerationStructureCompactedSize };
+// D3D12 has no push constant attribute, so constant buffers declared in this register space become root constants.
+// Declare them as [[vk::push_constant]] ConstantBuffer<T> name : register(bN, space1000) to match on Vulkan.
+constexpr uint32_t kRootConstantsSpace = 1000;
+
+enum class QueryHeapType { kAccelerationStructureCompactedSize, kTimestamp };
 
 template <typename T>
 auto operator<(const T& l, const T& r)
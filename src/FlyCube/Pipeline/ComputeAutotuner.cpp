@@ -0,0 +1,192 @@
+#include "Pipeline/ComputeAutotuner.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+
+namespace {
+
+// Identifies a variant in the table independently of its position in the variant list
+std::string GetVariantSignature(const ComputeAutotuneVariant& variant)
+{
+    std::string signature;
+    for (const auto& [name, value] : variant.define) {
+        signature += name + "=" + value + ";";
+    }
+    for (const auto& constant : variant.specialization_constants) {
+        signature += "#" + std::to_string(constant.id) + "=" + std::to_string(constant.value) + ";";
+    }
+    return signature;
+}
+
+uint32_t DivRoundUp(uint32_t value, uint32_t divisor)
+{
+    return (value + divisor - 1) / divisor;
+}
+
+} // namespace
+
+void ComputeAutotuneResult::DispatchThreads(CommandList& command_list,
+                                            uint32_t total_x,
+                                            uint32_t total_y,
+                                            uint32_t total_z) const
+{
+    command_list.Dispatch(DivRoundUp(total_x, numthreads[0]), DivRoundUp(total_y, numthreads[1]),
+                          DivRoundUp(total_z, numthreads[2]));
+}
+
+ComputeAutotuner::ComputeAutotuner(Device& device, const std::string& adapter_name, const std::string& table_path)
+    : m_device(device)
+    , m_adapter_name(adapter_name)
+    , m_table_path(table_path)
+{
+    LoadTable();
+}
+
+ComputeAutotuneResult ComputeAutotuner::Tune(const std::string& key, const ComputeAutotuneDesc& desc)
+{
+    assert(desc.shader.type == ShaderType::kCompute);
+    assert(!desc.variants.empty());
+    assert(key.find_first_of("\t\n") == std::string::npos);
+
+    std::vector<ShaderDesc> shader_descs;
+    for (const auto& variant : desc.variants) {
+        decltype(auto) shader_desc = shader_descs.emplace_back(desc.shader);
+        for (const auto& [name, value] : variant.define) {
+            shader_desc.define[name] = value;
+        }
+    }
+
+    auto it = m_table.find({ m_adapter_name, key });
+    if (it != m_table.end()) {
+        for (size_t i = 0; i < desc.variants.size(); ++i) {
+            if (GetVariantSignature(desc.variants[i]) == it->second) {
+                return CreateResult(desc, i, m_device.CompileShader(shader_descs[i]));
+            }
+        }
+    }
+
+    if (m_device.GetTimestampFrequency(CommandListType::kCompute) == 0) {
+        return CreateResult(desc, 0, m_device.CompileShader(shader_descs[0]));
+    }
+
+    std::vector<std::shared_ptr<Shader>> shaders = m_device.CompileShaders(shader_descs);
+    ComputeAutotuneResult best;
+    uint64_t best_ticks = std::numeric_limits<uint64_t>::max();
+    for (size_t i = 0; i < desc.variants.size(); ++i) {
+        ComputeAutotuneResult result = CreateResult(desc, i, shaders[i]);
+        uint64_t ticks = Measure(desc, result);
+        if (!best.pipeline || ticks < best_ticks) {
+            best = result;
+            best_ticks = ticks;
+        }
+    }
+
+    m_table[{ m_adapter_name, key }] = GetVariantSignature(desc.variants[best.variant_index]);
+    SaveTable();
+    return best;
+}
+
+ComputeAutotuneResult ComputeAutotuner::CreateResult(const ComputeAutotuneDesc& desc,
+                                                     size_t variant_index,
+                                                     const std::shared_ptr<Shader>& shader)
+{
+    ComputeAutotuneResult result = {};
+    result.variant_index = variant_index;
+    decltype(auto) numthreads = shader->GetReflection()->GetShaderFeatureInfo().numthreads;
+    for (size_t i = 0; i < numthreads.size(); ++i) {
+        result.numthreads[i] = std::max(numthreads[i], 1u);
+    }
+
+    ComputePipelineDesc pipeline_desc = {
+        m_device.CreateProgram({ shader }),
+        desc.layout,
+        desc.variants[variant_index].specialization_constants,
+    };
+    result.pipeline = m_device.CreateComputePipeline(pipeline_desc);
+    return result;
+}
+
+uint64_t ComputeAutotuner::Measure(const ComputeAutotuneDesc& desc, const ComputeAutotuneResult& result)
+{
+    auto query_heap = m_device.CreateQueryHeap(QueryHeapType::kTimestamp, 2);
+    auto timestamps = m_device.CreateBuffer(BindFlag::kCopyDest, 2 * sizeof(uint64_t));
+    timestamps->CommitMemory(MemoryType::kReadback);
+    auto command_list = m_device.CreateCommandList(CommandListType::kCompute);
+    command_list->ResetQueryHeap(query_heap, 0, 2);
+    command_list->BindPipeline(result.pipeline);
+    if (desc.binding_set) {
+        command_list->BindBindingSet(desc.binding_set);
+    }
+
+    // The first dispatch warms up caches and is left out of the measurement
+    result.DispatchThreads(*command_list, desc.thread_count[0], desc.thread_count[1], desc.thread_count[2]);
+    command_list->UAVResourceBarrier({});
+    command_list->WriteTimestamp(query_heap, 0);
+    for (uint32_t i = 0; i < desc.iteration_count; ++i) {
+        result.DispatchThreads(*command_list, desc.thread_count[0], desc.thread_count[1], desc.thread_count[2]);
+        command_list->UAVResourceBarrier({});
+    }
+    command_list->WriteTimestamp(query_heap, 1);
+    command_list->ResolveQueryData(query_heap, 0, 2, timestamps, 0);
+    command_list->Close();
+
+    auto fence = m_device.CreateFence(0);
+    auto command_queue = m_device.GetCommandQueue(CommandListType::kCompute);
+    command_queue->ExecuteCommandLists({ command_list });
+    command_queue->Signal(fence, 1);
+    fence->Wait(1);
+
+    uint64_t ticks[2] = {};
+    std::memcpy(ticks, timestamps->Map(), sizeof(ticks));
+    timestamps->Unmap();
+    if (ticks[1] < ticks[0]) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return ticks[1] - ticks[0];
+}
+
+void ComputeAutotuner::LoadTable()
+{
+    if (m_table_path.empty()) {
+        return;
+    }
+    std::ifstream file(std::filesystem::u8path(m_table_path));
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream line_stream(line);
+        std::string adapter_name;
+        std::string key;
+        std::string signature;
+        if (std::getline(line_stream, adapter_name, '\t') && std::getline(line_stream, key, '\t')) {
+            // A variant without defines and constants has an empty signature
+            std::getline(line_stream, signature);
+            m_table[{ adapter_name, key }] = signature;
+        }
+    }
+}
+
+void ComputeAutotuner::SaveTable() const
+{
+    if (m_table_path.empty()) {
+        return;
+    }
+    std::filesystem::path path = std::filesystem::u8path(m_table_path);
+    std::filesystem::path temp_path = path;
+    temp_path += ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::trunc);
+        for (const auto& [adapter_key, signature] : m_table) {
+            file << adapter_key.first << '\t' << adapter_key.second << '\t' << signature << '\n';
+        }
+        if (!file) {
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, path, ec);
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "Device/Device.h"
+#include "Instance/BaseTypes.h"
+
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+struct ComputeAutotuneVariant {
+    // Added to the defines of the tuned shader, usually the values used by its numthreads attribute
+    std::map<std::string, std::string> define;
+    std::vector<SpecializationConstant> specialization_constants;
+};
+
+// Representative workload every variant is timed on
+struct ComputeAutotuneDesc {
+    ShaderDesc shader;
+    std::vector<ComputeAutotuneVariant> variants;
+    std::shared_ptr<BindingSetLayout> layout;
+    std::shared_ptr<BindingSet> binding_set;
+    std::array<uint32_t, 3> thread_count = { 1, 1, 1 };
+    uint32_t iteration_count = 8;
+};
+
+struct ComputeAutotuneResult {
+    std::shared_ptr<Pipeline> pipeline;
+    size_t variant_index = 0;
+    // Reflected from the compiled variant
+    std::array<uint32_t, 3> numthreads = { 1, 1, 1 };
+
+    // Dispatches enough thread groups to cover the thread counts, the pipeline must be bound
+    void DispatchThreads(CommandList& command_list, uint32_t total_x, uint32_t total_y, uint32_t total_z) const;
+};
+
+// Picks the fastest variant of a compute shader by timing each one with GPU timestamps.
+// Winners are kept per adapter and tuning key in a small text table, so later runs only compile the winner.
+class ComputeAutotuner {
+public:
+    // An empty table_path keeps the results in memory only
+    ComputeAutotuner(Device& device, const std::string& adapter_name, const std::string& table_path);
+
+    // Reuses the stored winner while it is still one of the variants, otherwise times all of them.
+    // Without timestamp query support the first variant is returned and nothing is stored.
+    ComputeAutotuneResult Tune(const std::string& key, const ComputeAutotuneDesc& desc);
+
+private:
+    ComputeAutotuneResult CreateResult(const ComputeAutotuneDesc& desc,
+                                       size_t variant_index,
+                                       const std::shared_ptr<Shader>& shader);
+    uint64_t Measure(const ComputeAutotuneDesc& desc, const ComputeAutotuneResult& result);
+    void LoadTable();
+    void SaveTable() const;
+
+    Device& m_device;
+    std::string m_adapter_name;
+    std::string m_table_path;
+    // (adapter name, tuning key) -> signature of the winning variant
+    std::map<std::pair<std::string, std::string>, std::string> m_table;
+};
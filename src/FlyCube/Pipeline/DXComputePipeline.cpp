@@ -57,3 +57,8 @@ const ComPtr<ID3D12RootSignature>& DXComputePipeline::GetRootSignature() const
 {
     return m_root_signature;
 }
+
+const std::shared_ptr<BindingSetLayout>& DXComputePipeline::GetLayout() const
+{
+    return m_desc.layout;
+}
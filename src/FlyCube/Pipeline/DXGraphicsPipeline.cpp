@@ -191,6 +191,8 @@ DXGraphicsPipeline::DXGraphicsPipeline(DXDevice& device, const GraphicsPipelineD
     : m_device(device)
     , m_desc(desc)
 {
+    // The deduplicator drops depth_stencil_desc and rasterizer_desc from the key of dynamic pipelines
+    assert(!m_desc.dynamic_state || m_device.IsDynamicStateSupported());
     DXStateBuilder graphics_state_builder;
 
     decltype(auto) dx_program = m_desc.program->As<ProgramBase>();
@@ -290,6 +292,11 @@ const ComPtr<ID3D12RootSignature>& DXGraphicsPipeline::GetRootSignature() const
     return m_root_signature;
 }
 
+const std::shared_ptr<BindingSetLayout>& DXGraphicsPipeline::GetLayout() const
+{
+    return m_desc.layout;
+}
+
 const std::map<size_t, uint32_t>& DXGraphicsPipeline::GetStrideMap() const
 {
     return m_input_layout_stride;
@@ -14,6 +14,7 @@ public:
     DXGraphicsPipeline(DXDevice& device, const GraphicsPipelineDesc& desc);
     PipelineType GetPipelineType() const override;
     const ComPtr<ID3D12RootSignature>& GetRootSignature() const override;
+    const std::shared_ptr<BindingSetLayout>& GetLayout() const override;
 
     const GraphicsPipelineDesc& GetDesc() const;
     const ComPtr<ID3D12PipelineState>& GetPipeline() const;
@@ -9,5 +9,6 @@ class DXPipeline : public Pipeline {
 public:
     virtual ~DXPipeline() = default;
     virtual const ComPtr<ID3D12RootSignature>& GetRootSignature() const = 0;
+    virtual const std::shared_ptr<BindingSetLayout>& GetLayout() const = 0;
     std::vector<uint8_t> GetRayTracingShaderGroupHandles(uint32_t first_group, uint32_t group_count) const override;
 };
@@ -127,6 +127,11 @@ const ComPtr<ID3D12RootSignature>& DXRayTracingPipeline::GetRootSignature() cons
     return m_root_signature;
 }
 
+const std::shared_ptr<BindingSetLayout>& DXRayTracingPipeline::GetLayout() const
+{
+    return m_desc.layout;
+}
+
 std::vector<uint8_t> DXRayTracingPipeline::GetRayTracingShaderGroupHandles(uint32_t first_group,
                                                                            uint32_t group_count) const
 {
@@ -15,6 +15,7 @@ public:
     DXRayTracingPipeline(DXDevice& device, const RayTracingPipelineDesc& desc);
     PipelineType GetPipelineType() const override;
     const ComPtr<ID3D12RootSignature>& GetRootSignature() const override;
+    const std::shared_ptr<BindingSetLayout>& GetLayout() const override;
     std::vector<uint8_t> GetRayTracingShaderGroupHandles(uint32_t first_group, uint32_t group_count) const override;
 
     const ComPtr<ID3D12StateObject>& GetPipeline() const;
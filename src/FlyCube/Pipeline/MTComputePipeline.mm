@@ -16,7 +16,8 @@ MTComputePipeline::MTComputePipeline(MTDevice& device, const ComputePipelineDesc
         id<MTLLibrary> library = mt_shader.GetLibrary();
         decltype(auto) reflection = shader->GetReflection();
         for (const auto& entry_point : reflection->GetEntryPoints()) {
-            id<MTLFunction> function = mt_shader.CreateFunction(library, entry_point.name);
+            id<MTLFunction> function =
+                mt_shader.CreateFunction(library, entry_point.name, desc.specialization_constants);
             switch (shader->GetType()) {
             case ShaderType::kCompute:
                 pipeline_descriptor.computeFunction = function;
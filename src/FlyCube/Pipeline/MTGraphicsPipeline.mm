@@ -90,6 +90,8 @@ MTGraphicsPipeline::MTGraphicsPipeline(MTDevice& device, const GraphicsPipelineD
     : m_device(device)
     , m_desc(desc)
 {
+    // The deduplicator drops depth_stencil_desc and rasterizer_desc from the key of dynamic pipelines
+    assert(!m_desc.dynamic_state || m_device.IsDynamicStateSupported());
     if (m_desc.program->HasShader(ShaderType::kAmplification) || m_desc.program->HasShader(ShaderType::kMesh)) {
         CreatePipeline</*is_mesh_pipeline=*/true>();
     } else {
@@ -110,7 +112,8 @@ void MTGraphicsPipeline::CreatePipeline()
         id<MTLLibrary> library = mt_shader.GetLibrary();
         decltype(auto) reflection = shader->GetReflection();
         for (const auto& entry_point : reflection->GetEntryPoints()) {
-            id<MTLFunction> function = mt_shader.CreateFunction(library, entry_point.name);
+            id<MTLFunction> function =
+                mt_shader.CreateFunction(library, entry_point.name, m_desc.specialization_constants);
             switch (shader->GetType()) {
             case ShaderType::kVertex:
                 if constexpr (!is_mesh_pipeline) {
@@ -0,0 +1,26 @@
+#include "Pipeline/PendingPipeline.h"
+
+#include <chrono>
+
+PendingPipeline::PendingPipeline(std::shared_future<std::shared_ptr<Pipeline>> future)
+    : m_future(std::move(future))
+{
+}
+
+bool PendingPipeline::IsReady() const
+{
+    return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+const std::shared_ptr<Pipeline>& PendingPipeline::Wait() const
+{
+    return m_future.get();
+}
+
+std::shared_ptr<Pipeline> PendingPipeline::GetPipeline() const
+{
+    if (!IsReady()) {
+        return nullptr;
+    }
+    return m_future.get();
+}
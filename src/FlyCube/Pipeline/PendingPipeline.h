@@ -0,0 +1,20 @@
+#pragma once
+#include "Pipeline/Pipeline.h"
+
+#include <future>
+#include <memory>
+
+// Pipeline being created on the thread pool, returned by Device::Create*PipelineAsync
+class PendingPipeline {
+public:
+    explicit PendingPipeline(std::shared_future<std::shared_ptr<Pipeline>> future);
+
+    bool IsReady() const;
+    // Blocks until the pipeline is created
+    const std::shared_ptr<Pipeline>& Wait() const;
+    // Returns nullptr until the pipeline is created
+    std::shared_ptr<Pipeline> GetPipeline() const;
+
+private:
+    std::shared_future<std::shared_ptr<Pipeline>> m_future;
+};
@@ -0,0 +1,260 @@
+#include "Pipeline/PipelineDeduplicator.h"
+
+#include "Program/Program.h"
+#include "RenderPass/RenderPass.h"
+#include "Utilities/Hash.h"
+
+#include <algorithm>
+#include <type_traits>
+
+namespace {
+
+constexpr size_t kMinRemoveExpiredThreshold = 64;
+
+enum class PipelineKeyType : uint8_t {
+    kGraphics,
+    kCompute,
+    kRayTracing,
+};
+
+class PipelineKeyBuilder {
+public:
+    explicit PipelineKeyBuilder(PipelineKeyType type)
+    {
+        Add(type);
+    }
+
+    template <typename T>
+    void Add(const T& value)
+    {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>);
+        m_key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void Add(const std::string& str)
+    {
+        Add<uint64_t>(str.size());
+        m_key.append(str);
+    }
+
+    void Add(const std::shared_ptr<Program>& program)
+    {
+        decltype(auto) shaders = program->GetShaders();
+        Add<uint64_t>(shaders.size());
+        for (const auto& shader : shaders) {
+            decltype(auto) entry_points = shader->GetReflection()->GetEntryPoints();
+            Add(shader->GetType());
+            Add<uint64_t>(entry_points.size());
+            for (const auto& entry_point : entry_points) {
+                Add(shader->GetId(entry_point.name));
+            }
+        }
+    }
+
+    void Add(const std::shared_ptr<BindingSetLayout>& layout)
+    {
+        // Pipelines keep their layout alive, so the address can't be reused while an entry is live
+        Add(reinterpret_cast<uintptr_t>(layout.get()));
+    }
+
+    void Add(const std::vector<SpecializationConstant>& specialization_constants)
+    {
+        Add<uint64_t>(specialization_constants.size());
+        for (const auto& constant : specialization_constants) {
+            Add(constant.id);
+            Add(constant.value);
+        }
+    }
+
+    void Add(const std::vector<InputLayoutDesc>& input)
+    {
+        Add<uint64_t>(input.size());
+        for (const auto& desc : input) {
+            Add(desc.slot);
+            Add(desc.semantic_name);
+            Add(desc.format);
+            Add(desc.stride);
+        }
+    }
+
+    void Add(const RenderPassDesc& desc)
+    {
+        Add<uint64_t>(desc.colors.size());
+        for (const auto& color : desc.colors) {
+            Add(color.format);
+            Add(color.load_op);
+            Add(color.store_op);
+        }
+        Add(desc.depth_stencil.format);
+        Add(desc.depth_stencil.depth_load_op);
+        Add(desc.depth_stencil.depth_store_op);
+        Add(desc.depth_stencil.stencil_load_op);
+        Add(desc.depth_stencil.stencil_store_op);
+        Add(desc.shading_rate_format);
+        Add(desc.sample_count);
+    }
+
+    void Add(const StencilOpDesc& desc)
+    {
+        Add(desc.fail_op);
+        Add(desc.depth_fail_op);
+        Add(desc.pass_op);
+        Add(desc.func);
+    }
+
+    void Add(const DepthStencilDesc& desc)
+    {
+        Add(desc.depth_test_enable);
+        Add(desc.depth_func);
+        Add(desc.depth_write_enable);
+        Add(desc.depth_bounds_test_enable);
+        Add(desc.stencil_enable);
+        Add(desc.stencil_read_mask);
+        Add(desc.stencil_write_mask);
+        Add(desc.front_face);
+        Add(desc.back_face);
+    }
+
+    void Add(const BlendDesc& desc)
+    {
+        Add(desc.blend_enable);
+        if (!desc.blend_enable) {
+            // The remaining fields are ignored and may be left uninitialized
+            return;
+        }
+        Add(desc.blend_src);
+        Add(desc.blend_dest);
+        Add(desc.blend_op);
+        Add(desc.blend_src_alpha);
+        Add(desc.blend_dest_apha);
+        Add(desc.blend_op_alpha);
+    }
+
+    void Add(const RasterizerDesc& desc)
+    {
+        Add(desc.fill_mode);
+        Add(desc.cull_mode);
+        Add(desc.depth_bias);
+    }
+
+    void Add(const std::vector<RayTracingShaderGroup>& groups)
+    {
+        Add<uint64_t>(groups.size());
+        for (const auto& group : groups) {
+            Add(group.type);
+            Add(group.general);
+            Add(group.closest_hit);
+            Add(group.any_hit);
+            Add(group.intersection);
+        }
+    }
+
+    const std::string& GetKey() const
+    {
+        return m_key;
+    }
+
+private:
+    std::string m_key;
+};
+
+} // namespace
+
+size_t PipelineDeduplicator::KeyHash::operator()(const std::string& key) const
+{
+    return static_cast<size_t>(HashBytes(key.data(), key.size()));
+}
+
+std::shared_ptr<Pipeline> PipelineDeduplicator::GetOrCreate(const GraphicsPipelineDesc& desc,
+                                                            const CreatePipelineFn& create)
+{
+    PipelineKeyBuilder builder(PipelineKeyType::kGraphics);
+    builder.Add(desc.program);
+    builder.Add(desc.layout);
+    builder.Add(desc.input);
+    builder.Add(desc.render_pass->GetDesc());
+    builder.Add(desc.blend_desc);
+    builder.Add(desc.specialization_constants);
+    builder.Add(desc.dynamic_state);
+    if (!desc.dynamic_state) {
+        builder.Add(desc.depth_stencil_desc);
+        builder.Add(desc.rasterizer_desc);
+    }
+    return GetOrCreate(builder.GetKey(), create);
+}
+
+std::shared_ptr<Pipeline> PipelineDeduplicator::GetOrCreate(const ComputePipelineDesc& desc,
+                                                            const CreatePipelineFn& create)
+{
+    PipelineKeyBuilder builder(PipelineKeyType::kCompute);
+    builder.Add(desc.program);
+    builder.Add(desc.layout);
+    builder.Add(desc.specialization_constants);
+    return GetOrCreate(builder.GetKey(), create);
+}
+
+std::shared_ptr<Pipeline> PipelineDeduplicator::GetOrCreate(const RayTracingPipelineDesc& desc,
+                                                            const CreatePipelineFn& create)
+{
+    PipelineKeyBuilder builder(PipelineKeyType::kRayTracing);
+    builder.Add(desc.program);
+    builder.Add(desc.layout);
+    builder.Add(desc.groups);
+    builder.Add(desc.specialization_constants);
+    return GetOrCreate(builder.GetKey(), create);
+}
+
+uint64_t PipelineDeduplicator::GetHitCount() const
+{
+    return m_hit_count;
+}
+
+uint64_t PipelineDeduplicator::GetMissCount() const
+{
+    return m_miss_count;
+}
+
+std::shared_ptr<Pipeline> PipelineDeduplicator::GetOrCreate(const std::string& key, const CreatePipelineFn& create)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_pipelines.find(key);
+        if (it != m_pipelines.end()) {
+            if (auto pipeline = it->second.lock()) {
+                ++m_hit_count;
+                return pipeline;
+            }
+        }
+    }
+
+    // Created without the lock, pipeline creation is slow and may run on several threads at once
+    ++m_miss_count;
+    std::shared_ptr<Pipeline> pipeline = create();
+    if (!pipeline) {
+        return pipeline;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::weak_ptr<Pipeline>& entry = m_pipelines[key];
+    if (auto existing = entry.lock()) {
+        // Another thread finished the same pipeline first
+        return existing;
+    }
+    entry = pipeline;
+    if (m_pipelines.size() >= m_remove_expired_threshold) {
+        RemoveExpired();
+    }
+    return pipeline;
+}
+
+void PipelineDeduplicator::RemoveExpired()
+{
+    for (auto it = m_pipelines.begin(); it != m_pipelines.end();) {
+        if (it->second.expired()) {
+            it = m_pipelines.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    m_remove_expired_threshold = std::max(kMinRemoveExpiredThreshold, m_pipelines.size() * 2);
+}
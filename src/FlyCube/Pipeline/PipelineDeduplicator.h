@@ -0,0 +1,39 @@
+#pragma once
+#include "Instance/BaseTypes.h"
+#include "Pipeline/Pipeline.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Returns the live pipeline created from an equivalent desc instead of building a new driver pipeline.
+// Programs match by the ids of their shaders, layouts by object and render passes by their desc.
+// Only weak references are kept, a pipeline is evicted once the last user releases it.
+class PipelineDeduplicator {
+public:
+    using CreatePipelineFn = std::function<std::shared_ptr<Pipeline>()>;
+
+    std::shared_ptr<Pipeline> GetOrCreate(const GraphicsPipelineDesc& desc, const CreatePipelineFn& create);
+    std::shared_ptr<Pipeline> GetOrCreate(const ComputePipelineDesc& desc, const CreatePipelineFn& create);
+    std::shared_ptr<Pipeline> GetOrCreate(const RayTracingPipelineDesc& desc, const CreatePipelineFn& create);
+    uint64_t GetHitCount() const;
+    uint64_t GetMissCount() const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const std::string& key) const;
+    };
+
+    std::shared_ptr<Pipeline> GetOrCreate(const std::string& key, const CreatePipelineFn& create);
+    void RemoveExpired();
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::weak_ptr<Pipeline>, KeyHash> m_pipelines;
+    size_t m_remove_expired_threshold = 64;
+    std::atomic<uint64_t> m_hit_count = 0;
+    std::atomic<uint64_t> m_miss_count = 0;
+};
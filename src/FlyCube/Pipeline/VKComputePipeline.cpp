@@ -8,14 +8,14 @@
 #include <map>
 
 VKComputePipeline::VKComputePipeline(VKDevice& device, const ComputePipelineDesc& desc)
-    : VKPipeline(device, desc.program, desc.layout)
+    : VKPipeline(device, desc.program, desc.layout, desc.specialization_constants)
     , m_desc(desc)
 {
     vk::ComputePipelineCreateInfo pipeline_info = {};
     assert(m_shader_stage_create_info.size() == 1);
     pipeline_info.stage = m_shader_stage_create_info.front();
     pipeline_info.layout = m_pipeline_layout;
-    m_pipeline = m_device.GetDevice().createComputePipelineUnique({}, pipeline_info).value;
+    m_pipeline = m_device.GetDevice().createComputePipelineUnique(m_device.GetPipelineCache(), pipeline_info).value;
 }
 
 PipelineType VKComputePipeline::GetPipelineType() const
@@ -67,8 +67,49 @@ vk::StencilOpState Convert(const StencilOpDesc& desc, uint8_t read_mask, uint8_t
     return res;
 }
 
+vk::PolygonMode Convert(FillMode fill_mode)
+{
+    switch (fill_mode) {
+    case FillMode::kWireframe:
+        return vk::PolygonMode::eLine;
+    case FillMode::kSolid:
+        return vk::PolygonMode::eFill;
+    default:
+        assert(false);
+        return vk::PolygonMode::eFill;
+    }
+}
+
+vk::CullModeFlagBits Convert(CullMode cull_mode)
+{
+    switch (cull_mode) {
+    case CullMode::kNone:
+        return vk::CullModeFlagBits::eNone;
+    case CullMode::kFront:
+        return vk::CullModeFlagBits::eFront;
+    case CullMode::kBack:
+        return vk::CullModeFlagBits::eBack;
+    default:
+        assert(false);
+        return vk::CullModeFlagBits::eNone;
+    }
+}
+
+vk::PrimitiveTopology Convert(PrimitiveTopology topology)
+{
+    switch (topology) {
+    case PrimitiveTopology::kTriangleList:
+        return vk::PrimitiveTopology::eTriangleList;
+    case PrimitiveTopology::kTriangleStrip:
+        return vk::PrimitiveTopology::eTriangleStrip;
+    default:
+        assert(false);
+        return vk::PrimitiveTopology::eTriangleList;
+    }
+}
+
 VKGraphicsPipeline::VKGraphicsPipeline(VKDevice& device, const GraphicsPipelineDesc& desc)
-    : VKPipeline(device, desc.program, desc.layout)
+    : VKPipeline(device, desc.program, desc.layout, desc.specialization_constants)
     , m_desc(desc)
 {
     if (desc.program->HasShader(ShaderType::kVertex)) {
@@ -97,25 +138,8 @@ VKGraphicsPipeline::VKGraphicsPipeline(VKDevice& device, const GraphicsPipelineD
     rasterizer.frontFace = vk::FrontFace::eClockwise;
     rasterizer.depthBiasEnable = m_desc.rasterizer_desc.depth_bias != 0;
     rasterizer.depthBiasConstantFactor = m_desc.rasterizer_desc.depth_bias;
-    switch (m_desc.rasterizer_desc.fill_mode) {
-    case FillMode::kWireframe:
-        rasterizer.polygonMode = vk::PolygonMode::eLine;
-        break;
-    case FillMode::kSolid:
-        rasterizer.polygonMode = vk::PolygonMode::eFill;
-        break;
-    }
-    switch (m_desc.rasterizer_desc.cull_mode) {
-    case CullMode::kNone:
-        rasterizer.cullMode = vk::CullModeFlagBits::eNone;
-        break;
-    case CullMode::kFront:
-        rasterizer.cullMode = vk::CullModeFlagBits::eFront;
-        break;
-    case CullMode::kBack:
-        rasterizer.cullMode = vk::CullModeFlagBits::eBack;
-        break;
-    }
+    rasterizer.polygonMode = Convert(m_desc.rasterizer_desc.fill_mode);
+    rasterizer.cullMode = Convert(m_desc.rasterizer_desc.cull_mode);
 
     vk::PipelineColorBlendAttachmentState color_blend_attachment = {};
     color_blend_attachment.colorWriteMask = vk::ColorComponentFlagBits::eR | vk::ColorComponentFlagBits::eG |
@@ -184,6 +208,27 @@ VKGraphicsPipeline::VKGraphicsPipeline(VKDevice& device, const GraphicsPipelineD
         dynamic_state_enables.emplace_back(vk::DynamicState::eFragmentShadingRateKHR);
     }
 
+    if (m_desc.dynamic_state) {
+        assert(m_device.IsDynamicStateSupported());
+        std::vector<vk::DynamicState> extended_dynamic_states = {
+            vk::DynamicState::ePrimitiveTopologyEXT,
+            vk::DynamicState::ePolygonModeEXT,
+            vk::DynamicState::eCullModeEXT,
+            vk::DynamicState::eDepthBiasEnableEXT,
+            vk::DynamicState::eDepthBias,
+            vk::DynamicState::eDepthTestEnableEXT,
+            vk::DynamicState::eDepthWriteEnableEXT,
+            vk::DynamicState::eDepthCompareOpEXT,
+            vk::DynamicState::eDepthBoundsTestEnableEXT,
+            vk::DynamicState::eStencilTestEnableEXT,
+            vk::DynamicState::eStencilOpEXT,
+            vk::DynamicState::eStencilCompareMask,
+            vk::DynamicState::eStencilWriteMask,
+        };
+        dynamic_state_enables.insert(dynamic_state_enables.end(), extended_dynamic_states.begin(),
+                                     extended_dynamic_states.end());
+    }
+
     vk::PipelineDynamicStateCreateInfo pipelineDynamicStateCreateInfo{};
     pipelineDynamicStateCreateInfo.pDynamicStates = dynamic_state_enables.data();
     pipelineDynamicStateCreateInfo.dynamicStateCount = dynamic_state_enables.size();
@@ -202,7 +247,7 @@ VKGraphicsPipeline::VKGraphicsPipeline(VKDevice& device, const GraphicsPipelineD
     pipeline_info.renderPass = GetRenderPass();
     pipeline_info.pDynamicState = &pipelineDynamicStateCreateInfo;
 
-    m_pipeline = m_device.GetDevice().createGraphicsPipelineUnique({}, pipeline_info).value;
+    m_pipeline = m_device.GetDevice().createGraphicsPipelineUnique(m_device.GetPipelineCache(), pipeline_info).value;
 }
 
 PipelineType VKGraphicsPipeline::GetPipelineType() const
@@ -210,6 +255,11 @@ PipelineType VKGraphicsPipeline::GetPipelineType() const
     return PipelineType::kGraphics;
 }
 
+bool VKGraphicsPipeline::HasDynamicState() const
+{
+    return m_desc.dynamic_state;
+}
+
 vk::RenderPass VKGraphicsPipeline::GetRenderPass() const
 {
     return m_desc.render_pass->As<VKRenderPass>().GetRenderPass();
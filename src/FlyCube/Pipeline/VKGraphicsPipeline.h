@@ -7,6 +7,11 @@
 #include <vulkan/vulkan.hpp>
 
 vk::ShaderStageFlagBits ExecutionModel2Bit(ShaderKind kind);
+vk::CompareOp Convert(ComparisonFunc func);
+vk::StencilOp Convert(StencilOp op);
+vk::PolygonMode Convert(FillMode fill_mode);
+vk::CullModeFlagBits Convert(CullMode cull_mode);
+vk::PrimitiveTopology Convert(PrimitiveTopology topology);
 
 class VKDevice;
 
@@ -14,6 +19,8 @@ class VKGraphicsPipeline : public VKPipeline {
 public:
     VKGraphicsPipeline(VKDevice& device, const GraphicsPipelineDesc& desc);
     PipelineType GetPipelineType() const override;
+    // States set by the command list, see GraphicsPipelineDesc::dynamic_state
+    bool HasDynamicState() const;
 
     vk::RenderPass GetRenderPass() const;
 
@@ -2,6 +2,9 @@
 
 #include "BindingSetLayout/VKBindingSetLayout.h"
 #include "Device/VKDevice.h"
+#include "Shader/VKShader.h"
+
+#include <cstring>
 
 vk::ShaderStageFlagBits ExecutionModel2Bit(ShaderKind kind)
 {
@@ -38,29 +41,62 @@ vk::ShaderStageFlagBits ExecutionModel2Bit(ShaderKind kind)
 
 VKPipeline::VKPipeline(VKDevice& device,
                        const std::shared_ptr<Program>& program,
-                       const std::shared_ptr<BindingSetLayout>& layout)
+                       const std::shared_ptr<BindingSetLayout>& layout,
+                       const std::vector<SpecializationConstant>& specialization_constants)
     : m_device(device)
+    , m_layout(layout)
 {
     decltype(auto) vk_layout = layout->As<VKBindingSetLayout>();
     m_pipeline_layout = vk_layout.GetPipelineLayout();
 
     decltype(auto) shaders = program->GetShaders();
+    // The size of each entry must match the declared type, 16-bit constants take 2 bytes
+    std::map<uint32_t, uint32_t> constant_sizes;
     for (const auto& shader : shaders) {
-        decltype(auto) blob = shader->GetBlob();
-        vk::ShaderModuleCreateInfo shader_module_info = {};
-        shader_module_info.codeSize = blob.size();
-        shader_module_info.pCode = (uint32_t*)blob.data();
-        m_shader_modules.emplace_back(m_device.GetDevice().createShaderModuleUnique(shader_module_info));
+        for (const auto& desc : shader->GetReflection()->GetSpecializationConstants()) {
+            constant_sizes.emplace(desc.id, desc.size);
+        }
+    }
+
+    // Map entries of constant ids missing in a stage are ignored, so all stages share one specialization info
+    for (const auto& constant : specialization_constants) {
+        auto it = constant_sizes.find(constant.id);
+        uint32_t size = it != constant_sizes.end() ? it->second : sizeof(uint32_t);
+        size_t offset = m_specialization_data.size();
+        m_specialization_entries.emplace_back(constant.id, offset, size);
+        m_specialization_data.resize(offset + size);
+        if (size == sizeof(uint16_t)) {
+            uint16_t value = static_cast<uint16_t>(constant.value);
+            std::memcpy(m_specialization_data.data() + offset, &value, size);
+        } else {
+            assert(size == sizeof(uint32_t));
+            std::memcpy(m_specialization_data.data() + offset, &constant.value, size);
+        }
+    }
+    m_specialization_info.mapEntryCount = m_specialization_entries.size();
+    m_specialization_info.pMapEntries = m_specialization_entries.data();
+    m_specialization_info.dataSize = m_specialization_data.size();
+    m_specialization_info.pData = m_specialization_data.data();
 
+    for (const auto& shader : shaders) {
+        decltype(auto) vk_shader = shader->As<VKShader>();
         decltype(auto) reflection = shader->GetReflection();
         decltype(auto) entry_points = reflection->GetEntryPoints();
         for (const auto& entry_point : entry_points) {
             m_shader_ids[shader->GetId(entry_point.name)] = m_shader_stage_create_info.size();
             decltype(auto) shader_stage_create_info = m_shader_stage_create_info.emplace_back();
             shader_stage_create_info.stage = ExecutionModel2Bit(entry_point.kind);
-            shader_stage_create_info.module = m_shader_modules.back().get();
+            if (m_device.IsMaintenance5Supported()) {
+                // The driver consumes the code directly, no shader module object is created at all
+                shader_stage_create_info.pNext = &vk_shader.GetShaderModuleCreateInfo();
+            } else {
+                shader_stage_create_info.module = vk_shader.GetShaderModule();
+            }
             decltype(auto) name = entry_point_names.emplace_back(entry_point.name);
             shader_stage_create_info.pName = name.c_str();
+            if (!m_specialization_entries.empty()) {
+                shader_stage_create_info.pSpecializationInfo = &m_specialization_info;
+            }
         }
     }
 }
@@ -75,6 +111,11 @@ vk::PipelineLayout VKPipeline::GetPipelineLayout() const
     return m_pipeline_layout;
 }
 
+const std::shared_ptr<BindingSetLayout>& VKPipeline::GetLayout() const
+{
+    return m_layout;
+}
+
 std::vector<uint8_t> VKPipeline::GetRayTracingShaderGroupHandles(uint32_t first_group, uint32_t group_count) const
 {
     return {};
@@ -12,8 +12,10 @@ class VKPipeline : public Pipeline {
 public:
     VKPipeline(VKDevice& device,
                const std::shared_ptr<Program>& program,
-               const std::shared_ptr<BindingSetLayout>& layout);
+               const std::shared_ptr<BindingSetLayout>& layout,
+               const std::vector<SpecializationConstant>& specialization_constants);
     vk::PipelineLayout GetPipelineLayout() const;
+    const std::shared_ptr<BindingSetLayout>& GetLayout() const;
     vk::Pipeline GetPipeline() const;
     std::vector<uint8_t> GetRayTracingShaderGroupHandles(uint32_t first_group, uint32_t group_count) const override;
 
@@ -21,8 +23,11 @@ protected:
     VKDevice& m_device;
     std::deque<std::string> entry_point_names;
     std::vector<vk::PipelineShaderStageCreateInfo> m_shader_stage_create_info;
-    std::vector<vk::UniqueShaderModule> m_shader_modules;
+    std::vector<vk::SpecializationMapEntry> m_specialization_entries;
+    std::vector<uint8_t> m_specialization_data;
+    vk::SpecializationInfo m_specialization_info;
     vk::UniquePipeline m_pipeline;
+    std::shared_ptr<BindingSetLayout> m_layout;
     vk::PipelineLayout m_pipeline_layout;
     std::map<uint64_t, uint32_t> m_shader_ids;
 };
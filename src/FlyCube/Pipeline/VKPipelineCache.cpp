@@ -0,0 +1,131 @@
+#include "Pipeline/VKPipelineCache.h"
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+namespace {
+
+// VkPipelineCacheHeaderVersionOne
+constexpr size_t kHeaderSize = 16 + VK_UUID_SIZE;
+
+std::string GetTempSuffix()
+{
+    static std::atomic<uint64_t> counter = 0;
+    static const uint64_t seed = std::random_device()();
+    return ".tmp" + std::to_string(seed) + "_" + std::to_string(counter++);
+}
+
+} // namespace
+
+VKPipelineCache::VKPipelineCache(vk::Device device,
+                                 const vk::PhysicalDeviceProperties& properties,
+                                 const std::string& dir)
+    : m_device(device)
+    , m_properties(properties)
+    , m_dir(dir)
+{
+    if (!m_dir.empty()) {
+        std::stringstream name;
+        name << std::hex << std::setfill('0') << std::setw(8) << properties.vendorID << "_" << std::setw(8)
+             << properties.deviceID << "_" << std::setw(8) << properties.driverVersion << ".bin";
+        m_path = m_dir + "/" + name.str();
+    }
+
+    std::vector<uint8_t> data = ReadFile();
+    vk::PipelineCacheCreateInfo cache_info = {};
+    if (IsHeaderValid(data)) {
+        cache_info.initialDataSize = data.size();
+        cache_info.pInitialData = data.data();
+        m_loaded_size = data.size();
+    }
+    m_pipeline_cache = m_device.createPipelineCacheUnique(cache_info);
+}
+
+vk::PipelineCache VKPipelineCache::GetPipelineCache() const
+{
+    return m_pipeline_cache.get();
+}
+
+bool VKPipelineCache::Save()
+{
+    if (m_path.empty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_save_mutex);
+    // Only the destination of a merge needs external synchronization, the device cache stays usable meanwhile
+    std::vector<uint8_t> file_data = ReadFile();
+    vk::PipelineCacheCreateInfo cache_info = {};
+    if (IsHeaderValid(file_data)) {
+        cache_info.initialDataSize = file_data.size();
+        cache_info.pInitialData = file_data.data();
+    }
+    vk::UniquePipelineCache merged_cache = m_device.createPipelineCacheUnique(cache_info);
+    vk::PipelineCache src_cache = m_pipeline_cache.get();
+    m_device.mergePipelineCaches(merged_cache.get(), 1, &src_cache);
+    std::vector<uint8_t> data = m_device.getPipelineCacheData(merged_cache.get());
+    if (data.empty()) {
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::u8path(m_dir), ec);
+    auto path = std::filesystem::u8path(m_path);
+    auto temp_path = std::filesystem::u8path(m_path + GetTempSuffix());
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        file.close();
+        if (!file) {
+            std::filesystem::remove(temp_path, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+uint64_t VKPipelineCache::GetLoadedSize() const
+{
+    return m_loaded_size;
+}
+
+bool VKPipelineCache::IsHeaderValid(const std::vector<uint8_t>& data) const
+{
+    if (data.size() < kHeaderSize) {
+        return false;
+    }
+    uint32_t header[4] = {};
+    std::memcpy(header, data.data(), sizeof(header));
+    return header[0] >= kHeaderSize && header[0] <= data.size() &&
+           header[1] == static_cast<uint32_t>(vk::PipelineCacheHeaderVersion::eOne) &&
+           header[2] == m_properties.vendorID && header[3] == m_properties.deviceID &&
+           std::memcmp(data.data() + sizeof(header), m_properties.pipelineCacheUUID.data(), VK_UUID_SIZE) == 0;
+}
+
+std::vector<uint8_t> VKPipelineCache::ReadFile() const
+{
+    if (m_path.empty()) {
+        return {};
+    }
+    std::ifstream file(std::filesystem::u8path(m_path), std::ios::binary | std::ios::ate);
+    if (!file) {
+        return {};
+    }
+    std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(data.data()), data.size())) {
+        return {};
+    }
+    return data;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <vulkan/vulkan.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// VkPipelineCache persisted in dir, one file per vendor, device and driver version.
+// Data with a header written by another device or driver is ignored and the cache starts empty.
+class VKPipelineCache {
+public:
+    VKPipelineCache(vk::Device device, const vk::PhysicalDeviceProperties& properties, const std::string& dir);
+
+    vk::PipelineCache GetPipelineCache() const;
+    // Merges with the file written meanwhile by other processes and replaces it atomically
+    bool Save();
+    uint64_t GetLoadedSize() const;
+
+private:
+    bool IsHeaderValid(const std::vector<uint8_t>& data) const;
+    std::vector<uint8_t> ReadFile() const;
+
+    vk::Device m_device;
+    vk::PhysicalDeviceProperties m_properties;
+    std::string m_dir;
+    std::string m_path;
+    vk::UniquePipelineCache m_pipeline_cache;
+    uint64_t m_loaded_size = 0;
+    std::mutex m_save_mutex;
+};
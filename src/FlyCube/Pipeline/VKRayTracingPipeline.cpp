@@ -10,7 +10,7 @@
 #include <map>
 
 VKRayTracingPipeline::VKRayTracingPipeline(VKDevice& device, const RayTracingPipelineDesc& desc)
-    : VKPipeline(device, desc.program, desc.layout)
+    : VKPipeline(device, desc.program, desc.layout, desc.specialization_constants)
     , m_desc(desc)
 {
     std::vector<vk::RayTracingShaderGroupCreateInfoKHR> groups(m_desc.groups.size());
@@ -56,7 +56,8 @@ VKRayTracingPipeline::VKRayTracingPipeline(VKDevice& device, const RayTracingPip
     ray_pipeline_info.layout = m_pipeline_layout;
 
 #ifndef USE_STATIC_MOLTENVK
-    m_pipeline = m_device.GetDevice().createRayTracingPipelineKHRUnique({}, {}, ray_pipeline_info).value;
+    vk::PipelineCache pipeline_cache = m_device.GetPipelineCache();
+    m_pipeline = m_device.GetDevice().createRayTracingPipelineKHRUnique({}, pipeline_cache, ray_pipeline_info).value;
 #endif
 }
 
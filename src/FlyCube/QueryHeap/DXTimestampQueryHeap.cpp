@@ -0,0 +1,23 @@
+#include "QueryHeap/DXTimestampQueryHeap.h"
+
+#include "Device/DXDevice.h"
+#include "Utilities/DXUtility.h"
+
+DXTimestampQueryHeap::DXTimestampQueryHeap(DXDevice& device, QueryHeapType type, uint32_t count)
+    : m_device(device)
+{
+    D3D12_QUERY_HEAP_DESC desc = {};
+    desc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    desc.Count = count;
+    ASSERT_SUCCEEDED(m_device.GetDevice()->CreateQueryHeap(&desc, IID_PPV_ARGS(&m_query_heap)));
+}
+
+QueryHeapType DXTimestampQueryHeap::GetType() const
+{
+    return QueryHeapType::kTimestamp;
+}
+
+ComPtr<ID3D12QueryHeap> DXTimestampQueryHeap::GetQueryHeap() const
+{
+    return m_query_heap;
+}
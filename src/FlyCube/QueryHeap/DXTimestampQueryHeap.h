@@ -0,0 +1,21 @@
+#pragma once
+#include "QueryHeap/QueryHeap.h"
+
+#include <directx/d3d12.h>
+#include <wrl.h>
+using namespace Microsoft::WRL;
+
+class DXDevice;
+
+class DXTimestampQueryHeap : public QueryHeap {
+public:
+    DXTimestampQueryHeap(DXDevice& device, QueryHeapType type, uint32_t count);
+
+    QueryHeapType GetType() const override;
+
+    ComPtr<ID3D12QueryHeap> GetQueryHeap() const;
+
+private:
+    DXDevice& m_device;
+    ComPtr<ID3D12QueryHeap> m_query_heap;
+};
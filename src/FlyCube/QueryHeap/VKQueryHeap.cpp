@@ -4,9 +4,19 @@
 
 VKQueryHeap::VKQueryHeap(VKDevice& device, QueryHeapType type, uint32_t count)
     : m_device(device)
+    , m_type(type)
 {
-    assert(type == QueryHeapType::kAccelerationStructureCompactedSize);
-    m_query_type = vk::QueryType::eAccelerationStructureCompactedSizeKHR;
+    switch (type) {
+    case QueryHeapType::kAccelerationStructureCompactedSize:
+        m_query_type = vk::QueryType::eAccelerationStructureCompactedSizeKHR;
+        break;
+    case QueryHeapType::kTimestamp:
+        m_query_type = vk::QueryType::eTimestamp;
+        break;
+    default:
+        assert(false);
+        break;
+    }
     vk::QueryPoolCreateInfo desc = {};
     desc.queryCount = count;
     desc.queryType = m_query_type;
@@ -15,7 +25,7 @@ VKQueryHeap::VKQueryHeap(VKDevice& device, QueryHeapType type, uint32_t count)
 
 QueryHeapType VKQueryHeap::GetType() const
 {
-    return QueryHeapType::kAccelerationStructureCompactedSize;
+    return m_type;
 }
 
 vk::QueryType VKQueryHeap::GetQueryType() const
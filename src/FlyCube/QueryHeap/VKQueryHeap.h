@@ -16,6 +16,7 @@ public:
 
 private:
     VKDevice& m_device;
+    QueryHeapType m_type;
     vk::UniqueQueryPool m_query_pool;
     vk::QueryType m_query_type;
 };
@@ -11,13 +11,15 @@ class MTDevice;
 
 class MTShader : public ShaderBase {
 public:
-    MTShader(MTDevice& device, const std::vector<uint8_t>& blob, ShaderBlobType blob_type, ShaderType shader_type);
+    MTShader(MTDevice& device, const ShaderBlob& blob, ShaderBlobType blob_type, ShaderType shader_type);
     MTShader(MTDevice& device, const ShaderDesc& desc, ShaderBlobType blob_type);
 
     const std::string& GetSource() const;
     uint32_t GetIndex(BindKey bind_key) const;
     id<MTLLibrary> GetLibrary() const;
-    id<MTLFunction> CreateFunction(id<MTLLibrary> library, const std::string& entry_point);
+    id<MTLFunction> CreateFunction(id<MTLLibrary> library,
+                                   const std::string& entry_point,
+                                   const std::vector<SpecializationConstant>& specialization_constants);
 
 private:
     void CreateLibrary();
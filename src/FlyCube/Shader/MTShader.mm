@@ -2,6 +2,8 @@
 
 #include "Device/MTDevice.h"
 
+#include <algorithm>
+
 namespace {
 
 std::string FixEntryPoint(const std::string& entry_point)
@@ -12,9 +14,53 @@ std::string FixEntryPoint(const std::string& entry_point)
     return entry_point;
 }
 
+MTLFunctionConstantValues* CreateConstantValues(const std::vector<SpecializationConstantDesc>& constant_descs,
+                                                const std::vector<SpecializationConstant>& specialization_constants)
+{
+    MTLFunctionConstantValues* constant_values = [[MTLFunctionConstantValues alloc] init];
+    for (const auto& constant : specialization_constants) {
+        auto it = std::find_if(constant_descs.begin(), constant_descs.end(),
+                               [&](const SpecializationConstantDesc& desc) { return desc.id == constant.id; });
+        if (it == constant_descs.end()) {
+            continue;
+        }
+        if (it->size == sizeof(uint16_t) && it->type != VariableType::kBool) {
+            uint16_t value = static_cast<uint16_t>(constant.value);
+            MTLDataType data_type = MTLDataTypeUShort;
+            if (it->type == VariableType::kFloat) {
+                data_type = MTLDataTypeHalf;
+            } else if (it->type == VariableType::kInt) {
+                data_type = MTLDataTypeShort;
+            }
+            [constant_values setConstantValue:&value type:data_type atIndex:constant.id];
+            continue;
+        }
+        switch (it->type) {
+        case VariableType::kFloat:
+            [constant_values setConstantValue:&constant.value type:MTLDataTypeFloat atIndex:constant.id];
+            break;
+        case VariableType::kInt:
+            [constant_values setConstantValue:&constant.value type:MTLDataTypeInt atIndex:constant.id];
+            break;
+        case VariableType::kUint:
+            [constant_values setConstantValue:&constant.value type:MTLDataTypeUInt atIndex:constant.id];
+            break;
+        case VariableType::kBool: {
+            bool value = constant.value;
+            [constant_values setConstantValue:&value type:MTLDataTypeBool atIndex:constant.id];
+            break;
+        }
+        default:
+            // The function keeps the default value of constants without a Metal type
+            break;
+        }
+    }
+    return constant_values;
+}
+
 } // namespace
 
-MTShader::MTShader(MTDevice& device, const std::vector<uint8_t>& blob, ShaderBlobType blob_type, ShaderType shader_type)
+MTShader::MTShader(MTDevice& device, const ShaderBlob& blob, ShaderBlobType blob_type, ShaderType shader_type)
     : ShaderBase(blob, blob_type, shader_type, /*is_msl*/ true)
     , m_device(device)
 {
@@ -30,12 +76,12 @@ MTShader::MTShader(MTDevice& device, const ShaderDesc& desc, ShaderBlobType blob
 
 const std::string& MTShader::GetSource() const
 {
-    return m_msl_source;
+    return GetMSLSource();
 }
 
 uint32_t MTShader::GetIndex(BindKey bind_key) const
 {
-    return m_slot_remapping.at(m_bindings.at(m_mapping.at(bind_key)).name);
+    return GetMSLSlotRemapping().at(GetResourceBinding(bind_key).name);
 }
 
 id<MTLLibrary> MTShader::GetLibrary() const
@@ -43,10 +89,17 @@ id<MTLLibrary> MTShader::GetLibrary() const
     return m_library;
 }
 
-id<MTLFunction> MTShader::CreateFunction(id<MTLLibrary> library, const std::string& entry_point)
+id<MTLFunction> MTShader::CreateFunction(id<MTLLibrary> library,
+                                         const std::string& entry_point,
+                                         const std::vector<SpecializationConstant>& specialization_constants)
 {
     MTLFunctionDescriptor* desc = [MTLFunctionDescriptor functionDescriptor];
     desc.name = [NSString stringWithUTF8String:FixEntryPoint(entry_point).c_str()];
+    // spirv-cross declares [[vk::constant_id(N)]] constants as [[function_constant(N)]]
+    decltype(auto) constant_descs = GetReflection()->GetSpecializationConstants();
+    if (!constant_descs.empty()) {
+        desc.constantValues = CreateConstantValues(constant_descs, specialization_constants);
+    }
     NSError* error = nullptr;
     id<MTLFunction> function = [library newFunctionWithDescriptor:desc error:&error];
     if (function == nullptr) {
@@ -57,7 +110,7 @@ id<MTLFunction> MTShader::CreateFunction(id<MTLLibrary> library, const std::stri
 
 void MTShader::CreateLibrary()
 {
-    NSString* ns_source = [NSString stringWithUTF8String:m_msl_source.c_str()];
+    NSString* ns_source = [NSString stringWithUTF8String:GetMSLSource().c_str()];
     NSError* error = nullptr;
     m_library = [m_device.GetDevice() newLibraryWithSource:ns_source options:nullptr error:&error];
     if (m_library == nullptr) {
@@ -1,6 +1,7 @@
 #pragma once
 #include "Instance/BaseTypes.h"
 #include "Instance/QueryInterface.h"
+#include "Shader/ShaderBlob.h"
 #include "ShaderReflection/ShaderReflection.h"
 
 #include <memory>
@@ -9,7 +10,7 @@ class Shader : public QueryInterface {
 public:
     virtual ~Shader() = default;
     virtual ShaderType GetType() const = 0;
-    virtual const std::vector<uint8_t>& GetBlob() const = 0;
+    virtual const ShaderBlob& GetBlob() const = 0;
     virtual uint64_t GetId(const std::string& entry_point) const = 0;
     virtual const BindKey& GetBindKey(const std::string& name) const = 0;
     virtual const std::vector<ResourceBindingDesc>& GetResourceBindings() const = 0;
@@ -0,0 +1,181 @@
+#include "Shader/ShaderArchive.h"
+
+#include "Utilities/Hash.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+constexpr uint32_t kInvalidIndex = ~0u;
+
+uint64_t AlignOffset(uint64_t offset, uint64_t alignment)
+{
+    return (offset + (alignment - 1)) & ~(alignment - 1);
+}
+
+bool IsRangeValid(uint64_t offset, uint64_t size, uint64_t total_size)
+{
+    return offset <= total_size && size <= total_size - offset;
+}
+
+} // namespace
+
+ShaderArchive::ShaderArchive(const ShaderBlob& data)
+    : m_data(data)
+{
+    if (m_data.size() < sizeof(ShaderArchiveHeader)) {
+        return;
+    }
+    const ShaderArchiveHeader* header = reinterpret_cast<const ShaderArchiveHeader*>(m_data.data());
+    if (header->magic != kShaderArchiveMagic || header->version != kShaderArchiveVersion ||
+        header->bucket_count == 0 || (header->bucket_count & (header->bucket_count - 1)) != 0) {
+        return;
+    }
+    uint64_t entries_offset = sizeof(ShaderArchiveHeader) + uint64_t{ header->bucket_count } * sizeof(uint32_t);
+    uint64_t entries_end = entries_offset + uint64_t{ header->entry_count } * sizeof(ShaderArchiveEntry);
+    if (entries_end > m_data.size()) {
+        return;
+    }
+
+    // Validated once here so that lookups do not need bounds checks
+    const uint32_t* buckets = reinterpret_cast<const uint32_t*>(m_data.data() + sizeof(ShaderArchiveHeader));
+    for (uint32_t i = 0; i < header->bucket_count; ++i) {
+        if (buckets[i] != kInvalidIndex && buckets[i] >= header->entry_count) {
+            return;
+        }
+    }
+
+    const ShaderArchiveEntry* entries = reinterpret_cast<const ShaderArchiveEntry*>(m_data.data() + entries_offset);
+    for (uint32_t i = 0; i < header->entry_count; ++i) {
+        decltype(auto) entry = entries[i];
+        if (!IsRangeValid(entry.blob_offset, entry.blob_size, m_data.size()) ||
+            !IsRangeValid(entry.reflection_offset, entry.reflection_size, m_data.size()) ||
+            !IsRangeValid(entry.msl_offset, entry.msl_size, m_data.size()) ||
+            !IsRangeValid(entry.name_offset, entry.name_size, m_data.size()) ||
+            (entry.next != kInvalidIndex && entry.next >= header->entry_count)) {
+            return;
+        }
+    }
+
+    m_header = header;
+    m_buckets = buckets;
+    m_entries = entries;
+}
+
+bool ShaderArchive::IsValid() const
+{
+    return m_header != nullptr;
+}
+
+uint32_t ShaderArchive::GetEntryCount() const
+{
+    return m_header ? m_header->entry_count : 0;
+}
+
+ShaderBlob ShaderArchive::GetBlob(const std::string& name, ShaderBlobType blob_type) const
+{
+    if (!m_header) {
+        return {};
+    }
+
+    uint64_t hash = GetShaderArchiveHash(name, blob_type);
+    uint32_t index = m_buckets[hash & (m_header->bucket_count - 1)];
+    for (uint32_t i = 0; index != kInvalidIndex && i < m_header->entry_count; ++i) {
+        decltype(auto) entry = m_entries[index];
+        if (entry.hash == hash && entry.blob_type == static_cast<uint32_t>(blob_type) &&
+            entry.name_size == name.size() &&
+            std::memcmp(m_data.data() + entry.name_offset, name.data(), name.size()) == 0) {
+            ShaderBlob blob = m_data.Slice(entry.blob_offset, entry.blob_size);
+            if (entry.reflection_size) {
+                blob.SetReflectionRecord(m_data.Slice(entry.reflection_offset, entry.reflection_size));
+            }
+            if (entry.msl_size) {
+                blob.SetMSLRecord(m_data.Slice(entry.msl_offset, entry.msl_size));
+            }
+            return blob;
+        }
+        index = entry.next;
+    }
+    return {};
+}
+
+uint64_t GetShaderArchiveHash(const std::string& name, ShaderBlobType blob_type)
+{
+    return Hasher().Update(name).Update(static_cast<uint32_t>(blob_type)).GetHash();
+}
+
+bool WriteShaderArchive(const std::string& path, const std::vector<ShaderArchiveItem>& items)
+{
+    ShaderArchiveHeader header = {};
+    header.magic = kShaderArchiveMagic;
+    header.version = kShaderArchiveVersion;
+    header.entry_count = static_cast<uint32_t>(items.size());
+    header.bucket_count = 1;
+    while (header.bucket_count < items.size() * 2) {
+        header.bucket_count *= 2;
+    }
+
+    std::vector<uint32_t> buckets(header.bucket_count, kInvalidIndex);
+    std::vector<ShaderArchiveEntry> entries(items.size());
+    uint64_t offset = sizeof(header) + buckets.size() * sizeof(uint32_t) + entries.size() * sizeof(ShaderArchiveEntry);
+    for (size_t i = 0; i < items.size(); ++i) {
+        decltype(auto) entry = entries[i];
+        entry.hash = GetShaderArchiveHash(items[i].name, items[i].blob_type);
+        entry.name_offset = static_cast<uint32_t>(offset);
+        entry.name_size = static_cast<uint32_t>(items[i].name.size());
+        entry.blob_type = static_cast<uint32_t>(items[i].blob_type);
+        decltype(auto) bucket = buckets[entry.hash & (header.bucket_count - 1)];
+        entry.next = bucket;
+        bucket = static_cast<uint32_t>(i);
+        offset += entry.name_size;
+    }
+    for (size_t i = 0; i < items.size(); ++i) {
+        offset = AlignOffset(offset, kShaderArchiveBlobAlignment);
+        entries[i].blob_offset = offset;
+        entries[i].blob_size = items[i].blob.size();
+        offset += entries[i].blob_size;
+    }
+    for (size_t i = 0; i < items.size(); ++i) {
+        entries[i].reflection_offset = offset;
+        entries[i].reflection_size = items[i].reflection.size();
+        offset += entries[i].reflection_size;
+    }
+    for (size_t i = 0; i < items.size(); ++i) {
+        entries[i].msl_offset = offset;
+        entries[i].msl_size = items[i].msl.size();
+        offset += entries[i].msl_size;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::u8path(path).parent_path(), ec);
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream file(std::filesystem::u8path(temp_path), std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(buckets.data()), buckets.size() * sizeof(uint32_t));
+        file.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ShaderArchiveEntry));
+        for (const auto& item : items) {
+            file.write(item.name.data(), item.name.size());
+        }
+        const char padding[kShaderArchiveBlobAlignment] = {};
+        for (size_t i = 0; i < items.size(); ++i) {
+            file.write(padding, entries[i].blob_offset - file.tellp());
+            file.write(reinterpret_cast<const char*>(items[i].blob.data()), items[i].blob.size());
+        }
+        for (const auto& item : items) {
+            file.write(reinterpret_cast<const char*>(item.reflection.data()), item.reflection.size());
+        }
+        for (const auto& item : items) {
+            file.write(reinterpret_cast<const char*>(item.msl.data()), item.msl.size());
+        }
+        file.close();
+        if (!file) {
+            std::filesystem::remove(std::filesystem::u8path(temp_path), ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(std::filesystem::u8path(temp_path), std::filesystem::u8path(path), ec);
+    return !ec;
+}
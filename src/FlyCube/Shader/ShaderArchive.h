@@ -0,0 +1,66 @@
+#pragma once
+#include "Instance/BaseTypes.h"
+#include "Shader/ShaderBlob.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Archive layout: header, hash buckets, entries, entry names, blobs, reflection and MSL records.
+// Blobs are aligned to kShaderArchiveBlobAlignment so they can be used in place from a mapped file.
+constexpr uint32_t kShaderArchiveMagic = 0x41534346; // FCSA
+constexpr uint32_t kShaderArchiveVersion = 3;
+constexpr uint64_t kShaderArchiveBlobAlignment = 64;
+constexpr const char* kShaderArchiveFileName = "shaders.fcsa";
+
+struct ShaderArchiveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_count;
+    // Power of two, each bucket holds the index of the first entry of its chain or ~0
+    uint32_t bucket_count;
+};
+
+struct ShaderArchiveEntry {
+    uint64_t hash;
+    uint64_t blob_offset;
+    uint64_t blob_size;
+    uint64_t reflection_offset;
+    uint64_t reflection_size;
+    uint64_t msl_offset;
+    uint64_t msl_size;
+    uint32_t name_offset;
+    uint32_t name_size;
+    uint32_t blob_type;
+    uint32_t next;
+};
+
+struct ShaderArchiveItem {
+    std::string name;
+    ShaderBlobType blob_type;
+    ShaderBlob blob;
+    // Optional, see SerializeShaderReflection
+    ShaderBlob reflection;
+    // Optional, see SerializeMSLShader
+    ShaderBlob msl;
+};
+
+class ShaderArchive {
+public:
+    // Returned blobs share ownership of data, so the archive may be destroyed before them
+    explicit ShaderArchive(const ShaderBlob& data);
+
+    bool IsValid() const;
+    uint32_t GetEntryCount() const;
+    // Empty if the archive has no such entry, records stored with it are attached
+    ShaderBlob GetBlob(const std::string& name, ShaderBlobType blob_type) const;
+
+private:
+    ShaderBlob m_data;
+    const ShaderArchiveHeader* m_header = nullptr;
+    const uint32_t* m_buckets = nullptr;
+    const ShaderArchiveEntry* m_entries = nullptr;
+};
+
+uint64_t GetShaderArchiveHash(const std::string& name, ShaderBlobType blob_type);
+bool WriteShaderArchive(const std::string& path, const std::vector<ShaderArchiveItem>& items);
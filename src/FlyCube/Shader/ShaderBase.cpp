@@ -2,12 +2,16 @@
 
 #include "HLSLCompiler/Compiler.h"
 #include "HLSLCompiler/MSLConverter.h"
+#include "ShaderReflection/SerializedReflection.h"
+
+#include <atomic>
+#include <cassert>
 
 namespace {
 
 uint64_t GenId()
 {
-    static uint64_t id = 0;
+    static std::atomic<uint64_t> id = 0;
     return ++id;
 }
 
@@ -18,41 +22,12 @@ ShaderBase::ShaderBase(const ShaderDesc& desc, ShaderBlobType blob_type, bool is
 {
 }
 
-ShaderBase::ShaderBase(const std::vector<uint8_t>& blob, ShaderBlobType blob_type, ShaderType shader_type, bool is_msl)
+ShaderBase::ShaderBase(const ShaderBlob& blob, ShaderBlobType blob_type, ShaderType shader_type, bool is_msl)
     : m_blob(blob)
     , m_blob_type(blob_type)
     , m_shader_type(shader_type)
+    , m_is_msl(is_msl)
 {
-    if (is_msl) {
-        m_msl_source = GetMSLShader(m_blob, m_slot_remapping);
-    }
-    m_reflection = CreateShaderReflection(blob_type, m_blob.data(), m_blob.size());
-    m_bindings = m_reflection->GetBindings();
-    for (uint32_t i = 0; i < m_bindings.size(); ++i) {
-        uint32_t remapped_slot = ~0;
-        if (is_msl) {
-            remapped_slot = m_slot_remapping.at(m_bindings[i].name);
-        }
-        BindKey bind_key = { m_shader_type,       m_bindings[i].type,  m_bindings[i].slot,
-                             m_bindings[i].space, m_bindings[i].count, remapped_slot };
-        m_bind_keys[m_bindings[i].name] = bind_key;
-        m_mapping[bind_key] = i;
-        m_binding_keys.emplace_back(bind_key);
-    }
-
-    decltype(auto) input_parameters = m_reflection->GetInputParameters();
-    for (uint32_t i = 0; i < input_parameters.size(); ++i) {
-        decltype(auto) layout = m_input_layout_descs.emplace_back();
-        layout.slot = i;
-        layout.semantic_name = input_parameters[i].semantic_name;
-        layout.format = input_parameters[i].format;
-        layout.stride = gli::detail::bits_per_pixel(layout.format) / 8;
-        m_locations[input_parameters[i].semantic_name] = input_parameters[i].location;
-    }
-
-    for (const auto& entry_point : m_reflection->GetEntryPoints()) {
-        m_ids.emplace(entry_point.name, GenId());
-    }
 }
 
 ShaderType ShaderBase::GetType() const
@@ -60,47 +35,125 @@ ShaderType ShaderBase::GetType() const
     return m_shader_type;
 }
 
-const std::vector<uint8_t>& ShaderBase::GetBlob() const
+const ShaderBlob& ShaderBase::GetBlob() const
 {
     return m_blob;
 }
 
 uint64_t ShaderBase::GetId(const std::string& entry_point) const
 {
+    std::call_once(m_ids_once, &ShaderBase::ParseIds, this);
     return m_ids.at(entry_point);
 }
 
 const BindKey& ShaderBase::GetBindKey(const std::string& name) const
 {
+    std::call_once(m_bind_keys_once, &ShaderBase::ParseBindKeys, this);
     return m_bind_keys.at(name);
 }
 
 const std::vector<ResourceBindingDesc>& ShaderBase::GetResourceBindings() const
 {
-    return m_bindings;
+    return GetReflection()->GetBindings();
 }
 
 const ResourceBindingDesc& ShaderBase::GetResourceBinding(const BindKey& bind_key) const
 {
-    return m_bindings.at(m_mapping.at(bind_key));
+    std::call_once(m_bind_keys_once, &ShaderBase::ParseBindKeys, this);
+    return GetResourceBindings().at(m_mapping.at(bind_key));
 }
 
 const std::vector<InputLayoutDesc>& ShaderBase::GetInputLayouts() const
 {
+    std::call_once(m_input_layouts_once, &ShaderBase::ParseInputLayouts, this);
     return m_input_layout_descs;
 }
 
 uint32_t ShaderBase::GetInputLayoutLocation(const std::string& semantic_name) const
 {
+    std::call_once(m_input_layouts_once, &ShaderBase::ParseInputLayouts, this);
     return m_locations.at(semantic_name);
 }
 
 const std::vector<BindKey>& ShaderBase::GetBindings() const
 {
+    std::call_once(m_bind_keys_once, &ShaderBase::ParseBindKeys, this);
     return m_binding_keys;
 }
 
 const std::shared_ptr<ShaderReflection>& ShaderBase::GetReflection() const
 {
+    std::call_once(m_reflection_once, &ShaderBase::ParseReflection, this);
     return m_reflection;
 }
+
+const std::string& ShaderBase::GetMSLSource() const
+{
+    std::call_once(m_msl_once, &ShaderBase::ParseMSL, this);
+    return m_msl_source;
+}
+
+const std::map<std::string, uint32_t>& ShaderBase::GetMSLSlotRemapping() const
+{
+    std::call_once(m_msl_once, &ShaderBase::ParseMSL, this);
+    return m_slot_remapping;
+}
+
+void ShaderBase::ParseReflection() const
+{
+    ShaderBlob reflection_record = m_blob.GetReflectionRecord();
+    if (!reflection_record.empty()) {
+        m_reflection = CreateSerializedReflection(reflection_record.data(), reflection_record.size(), m_blob.data(),
+                                                  m_blob.size());
+    }
+    if (!m_reflection) {
+        m_reflection = CreateShaderReflection(m_blob_type, m_blob.data(), m_blob.size());
+    }
+}
+
+void ShaderBase::ParseMSL() const
+{
+    assert(m_is_msl);
+    ShaderBlob msl_record = m_blob.GetMSLRecord();
+    if (msl_record.empty() || !ParseMSLShader(msl_record.data(), msl_record.size(), m_blob.data(), m_blob.size(),
+                                              m_msl_source, m_slot_remapping)) {
+        m_msl_source = GetMSLShader(m_blob.data(), m_blob.size(), m_slot_remapping);
+    }
+}
+
+void ShaderBase::ParseBindKeys() const
+{
+    decltype(auto) bindings = GetResourceBindings();
+    for (uint32_t i = 0; i < bindings.size(); ++i) {
+        uint32_t remapped_slot = ~0;
+        if (m_is_msl && !bindings[i].is_root_constant) {
+            remapped_slot = GetMSLSlotRemapping().at(bindings[i].name);
+        }
+        BindKey bind_key = { m_shader_type,     bindings[i].type,  bindings[i].slot,
+                             bindings[i].space, bindings[i].count, remapped_slot,
+                             bindings[i].is_root_constant };
+        m_bind_keys[bindings[i].name] = bind_key;
+        m_mapping[bind_key] = i;
+        m_binding_keys.emplace_back(bind_key);
+    }
+}
+
+void ShaderBase::ParseInputLayouts() const
+{
+    decltype(auto) input_parameters = GetReflection()->GetInputParameters();
+    for (uint32_t i = 0; i < input_parameters.size(); ++i) {
+        decltype(auto) layout = m_input_layout_descs.emplace_back();
+        layout.slot = i;
+        layout.semantic_name = input_parameters[i].semantic_name;
+        layout.format = input_parameters[i].format;
+        layout.stride = gli::detail::bits_per_pixel(layout.format) / 8;
+        m_locations[input_parameters[i].semantic_name] = input_parameters[i].location;
+    }
+}
+
+void ShaderBase::ParseIds() const
+{
+    for (const auto& entry_point : GetReflection()->GetEntryPoints()) {
+        m_ids.emplace(entry_point.name, GenId());
+    }
+}
@@ -4,13 +4,14 @@
 #include "ShaderReflection/ShaderReflection.h"
 
 #include <map>
+#include <mutex>
 
 class ShaderBase : public Shader {
 public:
-    ShaderBase(const std::vector<uint8_t>& blob, ShaderBlobType blob_type, ShaderType shader_type, bool is_msl = false);
+    ShaderBase(const ShaderBlob& blob, ShaderBlobType blob_type, ShaderType shader_type, bool is_msl = false);
     ShaderBase(const ShaderDesc& desc, ShaderBlobType blob_type, bool is_msl = false);
     ShaderType GetType() const override;
-    const std::vector<uint8_t>& GetBlob() const override;
+    const ShaderBlob& GetBlob() const override;
     uint64_t GetId(const std::string& entry_point) const override;
     const BindKey& GetBindKey(const std::string& name) const override;
     const std::vector<ResourceBindingDesc>& GetResourceBindings() const override;
@@ -21,17 +22,39 @@ public:
     const std::shared_ptr<ShaderReflection>& GetReflection() const override;
 
 protected:
-    std::vector<uint8_t> m_blob;
+    const std::string& GetMSLSource() const;
+    const std::map<std::string, uint32_t>& GetMSLSlotRemapping() const;
+
+private:
+    // Everything derived from reflection is built on first access, so e.g. a compute-only
+    // shader never pays for input layouts, and a shader that isn't bound by name never builds the name map
+    void ParseReflection() const;
+    void ParseMSL() const;
+    void ParseBindKeys() const;
+    void ParseInputLayouts() const;
+    void ParseIds() const;
+
+    ShaderBlob m_blob;
     ShaderBlobType m_blob_type;
     ShaderType m_shader_type;
-    std::map<std::string, uint64_t> m_ids;
-    std::vector<ResourceBindingDesc> m_bindings;
-    std::vector<BindKey> m_binding_keys;
-    std::map<BindKey, size_t> m_mapping;
-    std::map<std::string, BindKey> m_bind_keys;
-    std::vector<InputLayoutDesc> m_input_layout_descs;
-    std::map<std::string, uint32_t> m_locations;
-    std::shared_ptr<ShaderReflection> m_reflection;
-    std::map<std::string, uint32_t> m_slot_remapping;
-    std::string m_msl_source;
+    bool m_is_msl;
+
+    mutable std::once_flag m_reflection_once;
+    mutable std::shared_ptr<ShaderReflection> m_reflection;
+
+    mutable std::once_flag m_msl_once;
+    mutable std::string m_msl_source;
+    mutable std::map<std::string, uint32_t> m_slot_remapping;
+
+    mutable std::once_flag m_bind_keys_once;
+    mutable std::vector<BindKey> m_binding_keys;
+    mutable std::map<BindKey, size_t> m_mapping;
+    mutable std::map<std::string, BindKey> m_bind_keys;
+
+    mutable std::once_flag m_input_layouts_once;
+    mutable std::vector<InputLayoutDesc> m_input_layout_descs;
+    mutable std::map<std::string, uint32_t> m_locations;
+
+    mutable std::once_flag m_ids_once;
+    mutable std::map<std::string, uint64_t> m_ids;
 };
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Read-only view of shader bytecode that shares ownership of the memory holding it,
+// e.g. a compiled vector or a memory-mapped shader archive. Copies never copy the bytecode.
+// A null owner makes a non-owning view, the caller then keeps the memory alive as long as the shader.
+class ShaderBlob {
+public:
+    ShaderBlob() = default;
+
+    ShaderBlob(std::vector<uint8_t> blob)
+    {
+        auto owner = std::make_shared<const std::vector<uint8_t>>(std::move(blob));
+        m_data = owner->data();
+        m_size = owner->size();
+        m_owner = std::move(owner);
+    }
+
+    ShaderBlob(const uint8_t* data, size_t size, std::shared_ptr<const void> owner)
+        : m_data(data)
+        , m_size(size)
+        , m_owner(std::move(owner))
+    {
+    }
+
+    const uint8_t* data() const
+    {
+        return m_data;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    const uint8_t* begin() const
+    {
+        return m_data;
+    }
+
+    const uint8_t* end() const
+    {
+        return m_data + m_size;
+    }
+
+    ShaderBlob Slice(size_t offset, size_t size) const
+    {
+        return ShaderBlob(m_data + offset, size, m_owner);
+    }
+
+    // Record written by SerializeShaderReflection for this bytecode, shaders use it instead of parsing the bytecode
+    void SetReflectionRecord(const ShaderBlob& record)
+    {
+        m_reflection_record = std::make_shared<const ShaderBlob>(record);
+    }
+
+    ShaderBlob GetReflectionRecord() const
+    {
+        return m_reflection_record ? *m_reflection_record : ShaderBlob();
+    }
+
+    // Record written by SerializeMSLShader for this SPIR-V, Metal shaders use it instead of converting at runtime
+    void SetMSLRecord(const ShaderBlob& record)
+    {
+        m_msl_record = std::make_shared<const ShaderBlob>(record);
+    }
+
+    ShaderBlob GetMSLRecord() const
+    {
+        return m_msl_record ? *m_msl_record : ShaderBlob();
+    }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+    std::shared_ptr<const void> m_owner;
+    std::shared_ptr<const ShaderBlob> m_reflection_record;
+    std::shared_ptr<const ShaderBlob> m_msl_record;
+};
@@ -0,0 +1,232 @@
+#include "Shader/ShaderHotReloader.h"
+
+#include "HLSLCompiler/Compiler.h"
+#include "Utilities/ThreadPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <type_traits>
+
+namespace {
+
+// Ids of the new shader group entries are looked up by the entry point name they had in the old shaders
+uint64_t RemapShaderId(uint64_t id, const std::map<std::shared_ptr<Shader>, std::shared_ptr<Shader>>& replaced)
+{
+    if (id == 0) {
+        return id;
+    }
+    for (const auto& [old_shader, new_shader] : replaced) {
+        for (const auto& entry_point : old_shader->GetReflection()->GetEntryPoints()) {
+            if (old_shader->GetId(entry_point.name) == id) {
+                return new_shader->GetId(entry_point.name);
+            }
+        }
+    }
+    return id;
+}
+
+} // namespace
+
+const std::shared_ptr<Pipeline>& ReloadablePipeline::GetPipeline() const
+{
+    return m_pipeline;
+}
+
+const std::shared_ptr<Program>& ReloadablePipeline::GetProgram() const
+{
+    return std::visit([](const auto& desc) -> const std::shared_ptr<Program>& { return desc.program; }, m_desc);
+}
+
+ShaderHotReloader::ShaderHotReloader(Device& device, uint32_t frame_latency)
+    : m_device(device)
+    , m_blob_type(device.GetSupportedShaderBlobType())
+    , m_frame_latency(frame_latency)
+{
+}
+
+ShaderHotReloader::~ShaderHotReloader()
+{
+    for (auto& entry : m_entries) {
+        if (entry.task.valid()) {
+            entry.task.wait();
+        }
+    }
+}
+
+std::shared_ptr<Shader> ShaderHotReloader::CompileShader(const ShaderDesc& desc)
+{
+    CompileResult result = CompileWithDiagnostics(desc, m_blob_type);
+    if (result.blob.empty()) {
+        std::cout << result.diagnostics << std::endl;
+        return {};
+    }
+
+    Entry entry = {};
+    entry.desc = desc;
+    entry.shader = m_device.CreateShader(std::move(result.blob), m_blob_type, desc.type);
+    entry.dependencies = std::move(result.dependencies);
+    Watch(entry.dependencies);
+    m_entries.push_back(std::move(entry));
+    return m_entries.back().shader;
+}
+
+std::shared_ptr<Program> ShaderHotReloader::CreateProgram(const std::vector<std::shared_ptr<Shader>>& shaders)
+{
+    return m_device.CreateProgram(shaders);
+}
+
+std::shared_ptr<ReloadablePipeline> ShaderHotReloader::CreateGraphicsPipeline(const GraphicsPipelineDesc& desc)
+{
+    auto pipeline = std::make_shared<ReloadablePipeline>();
+    pipeline->m_desc = desc;
+    pipeline->m_pipeline = CreatePipeline(*pipeline);
+    m_pipelines.push_back(pipeline);
+    return pipeline;
+}
+
+std::shared_ptr<ReloadablePipeline> ShaderHotReloader::CreateComputePipeline(const ComputePipelineDesc& desc)
+{
+    auto pipeline = std::make_shared<ReloadablePipeline>();
+    pipeline->m_desc = desc;
+    pipeline->m_pipeline = CreatePipeline(*pipeline);
+    m_pipelines.push_back(pipeline);
+    return pipeline;
+}
+
+std::shared_ptr<ReloadablePipeline> ShaderHotReloader::CreateRayTracingPipeline(const RayTracingPipelineDesc& desc)
+{
+    auto pipeline = std::make_shared<ReloadablePipeline>();
+    pipeline->m_desc = desc;
+    pipeline->m_pipeline = CreatePipeline(*pipeline);
+    m_pipelines.push_back(pipeline);
+    return pipeline;
+}
+
+bool ShaderHotReloader::Update()
+{
+    ++m_frame;
+    m_retired.erase(std::remove_if(m_retired.begin(), m_retired.end(),
+                                   [&](const auto& retired) { return retired.first + m_frame_latency < m_frame; }),
+                    m_retired.end());
+
+    std::set<std::string> changes = m_watcher.PollChanges();
+    for (auto& entry : m_entries) {
+        bool affected = std::any_of(entry.dependencies.begin(), entry.dependencies.end(),
+                                    [&](const auto& dependency) { return changes.count(dependency.first); });
+        if (!affected) {
+            continue;
+        }
+        if (entry.task.valid()) {
+            entry.outdated = true;
+        } else {
+            Schedule(entry);
+        }
+    }
+
+    std::map<std::shared_ptr<Shader>, std::shared_ptr<Shader>> replaced;
+    for (auto& entry : m_entries) {
+        if (!entry.task.valid() || entry.task.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            continue;
+        }
+        CompileTask task = entry.task.get();
+        if (task.shader) {
+            replaced[entry.shader] = task.shader;
+            Retire(entry.shader);
+            entry.shader = task.shader;
+            entry.dependencies = std::move(task.dependencies);
+            Watch(entry.dependencies);
+        } else {
+            std::cout << task.diagnostics << std::endl;
+        }
+        if (entry.outdated) {
+            entry.outdated = false;
+            Schedule(entry);
+        }
+    }
+    if (replaced.empty()) {
+        return false;
+    }
+
+    // All affected pipelines are swapped within this call, so a frame never mixes old and new shaders
+    m_pipelines.erase(std::remove_if(m_pipelines.begin(), m_pipelines.end(),
+                                     [](const auto& pipeline) { return pipeline.expired(); }),
+                      m_pipelines.end());
+    for (const auto& weak_pipeline : m_pipelines) {
+        auto pipeline = weak_pipeline.lock();
+        std::vector<std::shared_ptr<Shader>> shaders = pipeline->GetProgram()->GetShaders();
+        bool affected = false;
+        for (auto& shader : shaders) {
+            auto it = replaced.find(shader);
+            if (it != replaced.end()) {
+                shader = it->second;
+                affected = true;
+            }
+        }
+        if (!affected) {
+            continue;
+        }
+
+        std::shared_ptr<Program> program = m_device.CreateProgram(shaders);
+        std::visit(
+            [&](auto& desc) {
+                Retire(desc.program);
+                desc.program = program;
+                if constexpr (std::is_same_v<std::decay_t<decltype(desc)>, RayTracingPipelineDesc>) {
+                    for (auto& group : desc.groups) {
+                        group.general = RemapShaderId(group.general, replaced);
+                        group.closest_hit = RemapShaderId(group.closest_hit, replaced);
+                        group.any_hit = RemapShaderId(group.any_hit, replaced);
+                        group.intersection = RemapShaderId(group.intersection, replaced);
+                    }
+                }
+            },
+            pipeline->m_desc);
+        Retire(pipeline->m_pipeline);
+        pipeline->m_pipeline = CreatePipeline(*pipeline);
+    }
+    return true;
+}
+
+void ShaderHotReloader::Watch(const ShaderCacheDependencies& dependencies)
+{
+    for (const auto& [path, hash] : dependencies) {
+        m_watcher.AddFile(path);
+    }
+}
+
+void ShaderHotReloader::Schedule(Entry& entry)
+{
+    entry.task = GetThreadPool().Submit([&device = m_device, desc = entry.desc, blob_type = m_blob_type] {
+        CompileResult result = CompileWithDiagnostics(desc, blob_type);
+        CompileTask task = {};
+        if (!result.blob.empty()) {
+            task.shader = device.CreateShader(std::move(result.blob), blob_type, desc.type);
+        }
+        task.diagnostics = std::move(result.diagnostics);
+        task.dependencies = std::move(result.dependencies);
+        return task;
+    });
+}
+
+std::shared_ptr<Pipeline> ShaderHotReloader::CreatePipeline(ReloadablePipeline& pipeline)
+{
+    return std::visit(
+        [&](const auto& desc) -> std::shared_ptr<Pipeline> {
+            using T = std::decay_t<decltype(desc)>;
+            if constexpr (std::is_same_v<T, GraphicsPipelineDesc>) {
+                return m_device.CreateGraphicsPipeline(desc);
+            } else if constexpr (std::is_same_v<T, ComputePipelineDesc>) {
+                return m_device.CreateComputePipeline(desc);
+            } else {
+                return m_device.CreateRayTracingPipeline(desc);
+            }
+        },
+        pipeline.m_desc);
+}
+
+void ShaderHotReloader::Retire(std::shared_ptr<void> object)
+{
+    m_retired.emplace_back(m_frame, std::move(object));
+}
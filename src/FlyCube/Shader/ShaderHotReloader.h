@@ -0,0 +1,75 @@
+#pragma once
+#include "Device/Device.h"
+#include "HLSLCompiler/ShaderCache.h"
+#include "Instance/BaseTypes.h"
+#include "Pipeline/Pipeline.h"
+#include "Program/Program.h"
+#include "Shader/Shader.h"
+#include "Utilities/FileWatcher.h"
+
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+class ReloadablePipeline {
+public:
+    const std::shared_ptr<Pipeline>& GetPipeline() const;
+    const std::shared_ptr<Program>& GetProgram() const;
+
+private:
+    friend class ShaderHotReloader;
+
+    std::variant<GraphicsPipelineDesc, ComputePipelineDesc, RayTracingPipelineDesc> m_desc;
+    std::shared_ptr<Pipeline> m_pipeline;
+};
+
+// Recompiles shaders in the background when their source or one of their includes changes on disk.
+// Only pipelines created through the reloader are rebuilt, shaders referenced elsewhere keep the old code.
+class ShaderHotReloader {
+public:
+    // Replaced objects are kept alive for frame_latency calls of Update, so in-flight frames can still use them
+    ShaderHotReloader(Device& device, uint32_t frame_latency);
+    ~ShaderHotReloader();
+
+    std::shared_ptr<Shader> CompileShader(const ShaderDesc& desc);
+    std::shared_ptr<Program> CreateProgram(const std::vector<std::shared_ptr<Shader>>& shaders);
+    std::shared_ptr<ReloadablePipeline> CreateGraphicsPipeline(const GraphicsPipelineDesc& desc);
+    std::shared_ptr<ReloadablePipeline> CreateComputePipeline(const ComputePipelineDesc& desc);
+    std::shared_ptr<ReloadablePipeline> CreateRayTracingPipeline(const RayTracingPipelineDesc& desc);
+
+    // Call once per frame from the thread recording command lists, before any of them is recorded.
+    // Returns true if some pipeline was replaced and prerecorded command lists must be recorded again.
+    bool Update();
+
+private:
+    struct CompileTask {
+        std::shared_ptr<Shader> shader;
+        std::string diagnostics;
+        ShaderCacheDependencies dependencies;
+    };
+
+    struct Entry {
+        ShaderDesc desc;
+        std::shared_ptr<Shader> shader;
+        ShaderCacheDependencies dependencies;
+        std::future<CompileTask> task;
+        bool outdated = false;
+    };
+
+    void Watch(const ShaderCacheDependencies& dependencies);
+    void Schedule(Entry& entry);
+    std::shared_ptr<Pipeline> CreatePipeline(ReloadablePipeline& pipeline);
+    void Retire(std::shared_ptr<void> object);
+
+    Device& m_device;
+    ShaderBlobType m_blob_type;
+    uint32_t m_frame_latency;
+    uint64_t m_frame = 0;
+    FileWatcher m_watcher;
+    std::vector<Entry> m_entries;
+    std::vector<std::weak_ptr<ReloadablePipeline>> m_pipelines;
+    std::vector<std::pair<uint64_t, std::shared_ptr<void>>> m_retired;
+};
@@ -0,0 +1,157 @@
+#include "Shader/ShaderPermutationManager.h"
+
+#include "Utilities/ThreadPool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace {
+
+uint32_t GetBitCount(size_t value_count)
+{
+    uint32_t bits = 0;
+    while ((size_t{ 1 } << bits) < value_count) {
+        ++bits;
+    }
+    return bits;
+}
+
+bool IsFutureReady(const std::shared_future<std::shared_ptr<Shader>>& future)
+{
+    return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+} // namespace
+
+ShaderPermutationManager::ShaderPermutationManager(Device& device,
+                                                   const ShaderDesc& base_desc,
+                                                   const std::vector<ShaderPermutationAxis>& axes,
+                                                   ShaderPermutationKey fallback_key)
+    : m_device(device)
+    , m_base_desc(base_desc)
+{
+    uint32_t shift = 0;
+    for (const auto& axis : axes) {
+        assert(!axis.values.empty());
+        uint32_t bits = GetBitCount(axis.values.size());
+        m_axes.push_back({ axis, shift, bits });
+        shift += bits;
+    }
+    assert(shift <= 64);
+
+    // Compiled inline rather than waited for on the thread pool, which would deadlock if the manager is created
+    // from a pool task while every worker is busy
+    m_fallback = m_device.CompileShader(GetDesc(fallback_key));
+    std::promise<std::shared_ptr<Shader>> fallback_promise;
+    fallback_promise.set_value(m_fallback);
+    decltype(auto) fallback_permutation = m_permutations[fallback_key];
+    fallback_permutation.future = fallback_promise.get_future().share();
+    fallback_permutation.shader = m_fallback;
+}
+
+ShaderPermutationManager::~ShaderPermutationManager()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& [key, permutation] : m_permutations) {
+        permutation.future.wait();
+    }
+}
+
+ShaderPermutationKey ShaderPermutationManager::GetKey(const std::map<std::string, std::string>& values) const
+{
+    ShaderPermutationKey key = 0;
+    for (const auto& [name, value] : values) {
+        key = SetAxisValue(key, name, value);
+    }
+    return key;
+}
+
+ShaderPermutationKey ShaderPermutationManager::SetAxisValue(ShaderPermutationKey key,
+                                                            const std::string& axis,
+                                                            const std::string& value) const
+{
+    const Axis* axis_info = GetAxis(axis);
+    if (!axis_info) {
+        return key;
+    }
+    ShaderPermutationKey mask = ((ShaderPermutationKey{ 1 } << axis_info->bits) - 1) << axis_info->shift;
+    return (key & ~mask) | (ShaderPermutationKey{ GetValueIndex(*axis_info, value) } << axis_info->shift);
+}
+
+ShaderDesc ShaderPermutationManager::GetDesc(ShaderPermutationKey key) const
+{
+    ShaderDesc desc = m_base_desc;
+    for (const auto& axis : m_axes) {
+        size_t index = (key >> axis.shift) & ((ShaderPermutationKey{ 1 } << axis.bits) - 1);
+        assert(index < axis.desc.values.size());
+        desc.define[axis.desc.name] = axis.desc.values[std::min(index, axis.desc.values.size() - 1)];
+    }
+    return desc;
+}
+
+std::shared_ptr<Shader> ShaderPermutationManager::GetShader(ShaderPermutationKey key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    decltype(auto) permutation = Request(key);
+    if (!permutation.shader && IsFutureReady(permutation.future)) {
+        permutation.shader = permutation.future.get();
+    }
+    return permutation.shader ? permutation.shader : m_fallback;
+}
+
+std::shared_ptr<Shader> ShaderPermutationManager::GetShaderSync(ShaderPermutationKey key)
+{
+    std::shared_future<std::shared_ptr<Shader>> future;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        future = Request(key).future;
+    }
+    return future.get();
+}
+
+bool ShaderPermutationManager::IsReady(ShaderPermutationKey key)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_permutations.find(key);
+    return it != m_permutations.end() && IsFutureReady(it->second.future) && it->second.future.get();
+}
+
+const ShaderPermutationManager::Axis* ShaderPermutationManager::GetAxis(const std::string& name) const
+{
+    auto it = std::find_if(m_axes.begin(), m_axes.end(), [&](const Axis& axis) { return axis.desc.name == name; });
+    if (it == m_axes.end()) {
+        return nullptr;
+    }
+    return &*it;
+}
+
+uint32_t ShaderPermutationManager::GetValueIndex(const Axis& axis, const std::string& value) const
+{
+    decltype(auto) values = axis.desc.values;
+    auto it = std::find(values.begin(), values.end(), value);
+    if (it == values.end()) {
+        return 0;
+    }
+    return std::distance(values.begin(), it);
+}
+
+ShaderPermutationManager::Permutation& ShaderPermutationManager::Request(ShaderPermutationKey key)
+{
+    auto it = m_permutations.find(key);
+    if (it != m_permutations.end()) {
+        return it->second;
+    }
+
+    decltype(auto) permutation = m_permutations[key];
+    auto compile = [&device = m_device, desc = GetDesc(key)]() -> std::shared_ptr<Shader> {
+        // A failed compilation still creates a shader, with an empty blob
+        std::shared_ptr<Shader> shader = device.CompileShader(desc);
+        if (!shader || shader->GetBlob().empty()) {
+            return nullptr;
+        }
+        return shader;
+    };
+    permutation.future = GetThreadPool().Submit(std::move(compile)).share();
+    return permutation;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "Device/Device.h"
+#include "Instance/BaseTypes.h"
+#include "Shader/Shader.h"
+
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct ShaderPermutationAxis {
+    // Name of the define, the first value is the default
+    std::string name;
+    std::vector<std::string> values;
+};
+
+// Value indices of all axes packed into as few bits as possible
+using ShaderPermutationKey = uint64_t;
+
+class ShaderPermutationManager {
+public:
+    ShaderPermutationManager(Device& device,
+                             const ShaderDesc& base_desc,
+                             const std::vector<ShaderPermutationAxis>& axes,
+                             ShaderPermutationKey fallback_key = 0);
+    ~ShaderPermutationManager();
+
+    // Axes missing from values use their default, unknown axes are ignored
+    ShaderPermutationKey GetKey(const std::map<std::string, std::string>& values) const;
+    ShaderPermutationKey SetAxisValue(ShaderPermutationKey key,
+                                      const std::string& axis,
+                                      const std::string& value) const;
+    ShaderDesc GetDesc(ShaderPermutationKey key) const;
+
+    // Never blocks: schedules the permutation on first request and returns the fallback until it is compiled successfully
+    std::shared_ptr<Shader> GetShader(ShaderPermutationKey key);
+    // Waits for the thread pool, must not be called from a pool task.
+    // Returns nullptr if the permutation failed to compile
+    std::shared_ptr<Shader> GetShaderSync(ShaderPermutationKey key);
+    // False while the permutation is compiling and if it failed to compile
+    bool IsReady(ShaderPermutationKey key);
+
+private:
+    struct Axis {
+        ShaderPermutationAxis desc;
+        uint32_t shift;
+        uint32_t bits;
+    };
+
+    struct Permutation {
+        std::shared_future<std::shared_ptr<Shader>> future;
+        std::shared_ptr<Shader> shader;
+    };
+
+    const Axis* GetAxis(const std::string& name) const;
+    uint32_t GetValueIndex(const Axis& axis, const std::string& value) const;
+    Permutation& Request(ShaderPermutationKey key);
+
+    Device& m_device;
+    ShaderDesc m_base_desc;
+    std::vector<Axis> m_axes;
+    std::shared_ptr<Shader> m_fallback;
+    std::mutex m_mutex;
+    std::map<ShaderPermutationKey, Permutation> m_permutations;
+};
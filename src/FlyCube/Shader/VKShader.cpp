@@ -0,0 +1,32 @@
+#include "Shader/VKShader.h"
+
+#include "Device/VKDevice.h"
+
+VKShader::VKShader(VKDevice& device, const ShaderBlob& blob, ShaderBlobType blob_type, ShaderType shader_type)
+    : ShaderBase(blob, blob_type, shader_type)
+    , m_device(device)
+{
+    m_shader_module_info.codeSize = GetBlob().size();
+    m_shader_module_info.pCode = reinterpret_cast<const uint32_t*>(GetBlob().data());
+}
+
+VKShader::VKShader(VKDevice& device, const ShaderDesc& desc, ShaderBlobType blob_type)
+    : ShaderBase(desc, blob_type)
+    , m_device(device)
+{
+    m_shader_module_info.codeSize = GetBlob().size();
+    m_shader_module_info.pCode = reinterpret_cast<const uint32_t*>(GetBlob().data());
+}
+
+vk::ShaderModule VKShader::GetShaderModule() const
+{
+    std::call_once(m_shader_module_once, [&] {
+        m_shader_module = m_device.GetDevice().createShaderModuleUnique(m_shader_module_info);
+    });
+    return m_shader_module.get();
+}
+
+const vk::ShaderModuleCreateInfo& VKShader::GetShaderModuleCreateInfo() const
+{
+    return m_shader_module_info;
+}
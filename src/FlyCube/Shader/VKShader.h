@@ -0,0 +1,25 @@
+#pragma once
+#include "Instance/BaseTypes.h"
+#include "Shader/ShaderBase.h"
+
+#include <vulkan/vulkan.hpp>
+
+#include <mutex>
+
+class VKDevice;
+
+class VKShader : public ShaderBase {
+public:
+    VKShader(VKDevice& device, const ShaderBlob& blob, ShaderBlobType blob_type, ShaderType shader_type);
+    VKShader(VKDevice& device, const ShaderDesc& desc, ShaderBlobType blob_type);
+
+    // Created on first use and shared by all pipelines built from this shader
+    vk::ShaderModule GetShaderModule() const;
+    const vk::ShaderModuleCreateInfo& GetShaderModuleCreateInfo() const;
+
+private:
+    VKDevice& m_device;
+    vk::ShaderModuleCreateInfo m_shader_module_info;
+    mutable std::once_flag m_shader_module_once;
+    mutable vk::UniqueShaderModule m_shader_module;
+};
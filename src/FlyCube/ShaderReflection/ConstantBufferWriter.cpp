@@ -0,0 +1,151 @@
+#include "ShaderReflection/ConstantBufferWriter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstring>
+
+namespace {
+
+uint32_t GetArrayStride(const VariableLayout& layout)
+{
+    assert(layout.elements > 0);
+    assert(layout.size % layout.elements == 0);
+    return layout.size / layout.elements;
+}
+
+bool IsIndex(const std::string& str)
+{
+    return !str.empty() && str.size() < 10 &&
+           std::all_of(str.begin(), str.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+} // namespace
+
+ConstantBufferWriter::ConstantBufferWriter(const VariableLayout& layout, uint8_t* mapped_data)
+    : m_layout(layout)
+    , m_data(layout.size)
+{
+    SetMappedData(mapped_data);
+}
+
+ConstantBufferHandle ConstantBufferWriter::GetHandle(const std::string& name) const
+{
+    const VariableLayout* layout = &m_layout;
+    ConstantBufferHandle handle = { 0, m_layout.size };
+    bool indexed = false;
+    size_t pos = 0;
+    while (pos < name.size()) {
+        if (name[pos] == '[') {
+            size_t end = name.find(']', pos);
+            if (layout->elements == 0 || indexed || end == std::string::npos) {
+                return {};
+            }
+            std::string index_str = name.substr(pos + 1, end - pos - 1);
+            if (!IsIndex(index_str)) {
+                return {};
+            }
+            uint32_t index = std::stoul(index_str);
+            if (index >= layout->elements) {
+                return {};
+            }
+            uint32_t stride = GetArrayStride(*layout);
+            handle.offset += index * stride;
+            handle.size = stride;
+            indexed = true;
+            pos = end + 1;
+            continue;
+        }
+
+        if (pos != 0 && name[pos++] != '.') {
+            return {};
+        }
+        if (layout->elements != 0 && !indexed) {
+            return {};
+        }
+        size_t end = std::min(name.find_first_of(".[", pos), name.size());
+        std::string member_name = name.substr(pos, end - pos);
+        auto it = std::find_if(layout->members.begin(), layout->members.end(),
+                               [&](const VariableLayout& member) { return member.name == member_name; });
+        if (it == layout->members.end()) {
+            return {};
+        }
+        layout = &*it;
+        handle.offset += layout->offset;
+        handle.size = layout->size;
+        indexed = false;
+        pos = end;
+    }
+    if (handle.offset + handle.size > m_layout.size) {
+        assert(false);
+        return {};
+    }
+    return handle;
+}
+
+void ConstantBufferWriter::Write(const ConstantBufferHandle& handle, const void* data, uint32_t size)
+{
+    assert(handle.IsValid());
+    assert(size <= handle.size);
+    uint8_t* dst = m_data.data() + handle.offset;
+    if (memcmp(dst, data, size) == 0) {
+        return;
+    }
+    memcpy(dst, data, size);
+    if (m_mapped_data) {
+        memcpy(m_mapped_data + handle.offset, data, size);
+    }
+    MarkDirty(handle.offset, size);
+}
+
+void ConstantBufferWriter::SetMappedData(uint8_t* mapped_data)
+{
+    m_mapped_data = mapped_data;
+    if (m_mapped_data) {
+        memcpy(m_mapped_data, m_data.data(), m_data.size());
+    }
+    MarkDirty(0, m_data.size());
+}
+
+const std::vector<uint8_t>& ConstantBufferWriter::GetData() const
+{
+    return m_data;
+}
+
+uint32_t ConstantBufferWriter::GetSize() const
+{
+    return m_data.size();
+}
+
+const ConstantBufferRange& ConstantBufferWriter::GetDirtyRange() const
+{
+    return m_dirty_range;
+}
+
+void ConstantBufferWriter::ResetDirtyRange()
+{
+    m_dirty_range = {};
+}
+
+void ConstantBufferWriter::MarkDirty(uint32_t offset, uint32_t size)
+{
+    if (m_dirty_range.size == 0) {
+        m_dirty_range = { offset, size };
+        return;
+    }
+    uint32_t begin = std::min(m_dirty_range.offset, offset);
+    uint32_t end = std::max(m_dirty_range.offset + m_dirty_range.size, offset + size);
+    m_dirty_range = { begin, end - begin };
+}
+
+const VariableLayout* FindConstantBufferLayout(const ShaderReflection& reflection, const std::string& name)
+{
+    decltype(auto) bindings = reflection.GetBindings();
+    decltype(auto) layouts = reflection.GetVariableLayouts();
+    for (size_t i = 0; i < bindings.size(); ++i) {
+        if (bindings[i].type == ViewType::kConstantBuffer && bindings[i].name == name) {
+            return &layouts[i];
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "ShaderReflection/ShaderReflection.h"
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Location of a constant buffer member resolved once by name, writes through it do no string lookups
+struct ConstantBufferHandle {
+    uint32_t offset = 0;
+    uint32_t size = 0;
+
+    bool IsValid() const
+    {
+        return size != 0;
+    }
+};
+
+struct ConstantBufferRange {
+    uint32_t offset = 0;
+    uint32_t size = 0;
+};
+
+// Packs constant buffer members at the offsets reported by shader reflection.
+// Values are kept in a CPU copy and, when mapped_data is set, written straight into the mapped upload memory.
+// Writes of unchanged bytes are skipped, the changed bytes are accumulated in a single dirty range.
+class ConstantBufferWriter {
+public:
+    explicit ConstantBufferWriter(const VariableLayout& layout, uint8_t* mapped_data = nullptr);
+
+    // Accepts member paths like "color", "lights[2]" or "lights[2].position",
+    // returns an invalid handle if the path doesn't match the layout
+    ConstantBufferHandle GetHandle(const std::string& name) const;
+
+    void Write(const ConstantBufferHandle& handle, const void* data, uint32_t size);
+
+    template <typename T>
+    void Write(const ConstantBufferHandle& handle, const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        Write(handle, &value, sizeof(value));
+    }
+
+    void SetMappedData(uint8_t* mapped_data);
+    const std::vector<uint8_t>& GetData() const;
+    uint32_t GetSize() const;
+
+    // Covers the whole buffer after construction and SetMappedData, empty when nothing has changed
+    const ConstantBufferRange& GetDirtyRange() const;
+    void ResetDirtyRange();
+
+private:
+    void MarkDirty(uint32_t offset, uint32_t size);
+
+    VariableLayout m_layout;
+    std::vector<uint8_t> m_data;
+    uint8_t* m_mapped_data = nullptr;
+    ConstantBufferRange m_dirty_range = {};
+};
+
+// Returns nullptr if the reflection has no constant buffer with this name
+const VariableLayout* FindConstantBufferLayout(const ShaderReflection& reflection, const std::string& name);
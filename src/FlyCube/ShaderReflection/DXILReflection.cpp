@@ -1,5 +1,6 @@
 #include "ShaderReflection/DXILReflection.h"
 
+#include "Utilities/Common.h"
 #include "Utilities/DXUtility.h"
 
 #include <assert.h>
@@ -212,6 +213,23 @@ ResourceBindingDesc GetBindingDesc(const D3D12_SHADER_INPUT_BIND_DESC& bind_desc
     desc.dimension = GetViewDimension(bind_desc);
     desc.return_type = GetReturnType(desc.type, bind_desc);
     desc.structure_stride = GetStructureStride(desc.type, bind_desc, reflection);
+    if (desc.type == ViewType::kConstantBuffer && desc.space == kRootConstantsSpace) {
+        ID3D12ShaderReflectionConstantBuffer* cbuffer = reflection->GetConstantBufferByName(bind_desc.Name);
+        D3D12_SHADER_BUFFER_DESC cbuffer_desc = {};
+        if (cbuffer && SUCCEEDED(cbuffer->GetDesc(&cbuffer_desc))) {
+            // The buffer size is rounded up to 16 bytes, the end of the last variable matches SPIR-V push constants
+            uint32_t size = 0;
+            for (UINT i = 0; i < cbuffer_desc.Variables; ++i) {
+                D3D12_SHADER_VARIABLE_DESC variable_desc = {};
+                if (SUCCEEDED(cbuffer->GetVariableByIndex(i)->GetDesc(&variable_desc))) {
+                    size = std::max(size, variable_desc.StartOffset + variable_desc.Size);
+                }
+            }
+            desc.is_root_constant = true;
+            desc.count = Align(size, sizeof(uint32_t)) / sizeof(uint32_t);
+        }
+        assert(desc.is_root_constant);
+    }
     return desc;
 }
 
@@ -230,6 +248,10 @@ VariableLayout GetVariableLayout(const std::string& name,
     layout.rows = type_desc.Rows;
     layout.columns = type_desc.Columns;
     layout.elements = type_desc.Elements;
+    if (layout.elements > 0) {
+        // Include the padding after the last element like SPIR-V does, so that size / elements is the stride
+        layout.size = Align((size + layout.elements - 1) / layout.elements, 16) * layout.elements;
+    }
     switch (type_desc.Type) {
     case D3D_SHADER_VARIABLE_TYPE::D3D_SVT_FLOAT:
         layout.type = VariableType::kFloat;
@@ -333,6 +355,12 @@ std::vector<InputParameterDesc> ParseInputParameters(const D3D12_SHADER_DESC& de
                 input.format = gli::format::FORMAT_R32_SINT_PACK32;
             } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT32) {
                 input.format = gli::format::FORMAT_R32_SFLOAT_PACK32;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_UINT16) {
+                input.format = gli::format::FORMAT_R16_UINT_PACK16;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_SINT16) {
+                input.format = gli::format::FORMAT_R16_SINT_PACK16;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT16) {
+                input.format = gli::format::FORMAT_R16_SFLOAT_PACK16;
             }
         } else if (param_desc.Mask <= 3) {
             if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_UINT32) {
@@ -341,6 +369,12 @@ std::vector<InputParameterDesc> ParseInputParameters(const D3D12_SHADER_DESC& de
                 input.format = gli::format::FORMAT_RG32_SINT_PACK32;
             } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT32) {
                 input.format = gli::format::FORMAT_RG32_SFLOAT_PACK32;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_UINT16) {
+                input.format = gli::format::FORMAT_RG16_UINT_PACK16;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_SINT16) {
+                input.format = gli::format::FORMAT_RG16_SINT_PACK16;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT16) {
+                input.format = gli::format::FORMAT_RG16_SFLOAT_PACK16;
             }
         } else if (param_desc.Mask <= 7) {
             if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_UINT32) {
@@ -349,6 +383,12 @@ std::vector<InputParameterDesc> ParseInputParameters(const D3D12_SHADER_DESC& de
                 input.format = gli::format::FORMAT_RGB32_SINT_PACK32;
             } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT32) {
                 input.format = gli::format::FORMAT_RGB32_SFLOAT_PACK32;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_UINT16) {
+                input.format = gli::format::FORMAT_RGB16_UINT_PACK16;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_SINT16) {
+                input.format = gli::format::FORMAT_RGB16_SINT_PACK16;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT16) {
+                input.format = gli::format::FORMAT_RGB16_SFLOAT_PACK16;
             }
         } else if (param_desc.Mask <= 15) {
             if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_UINT32) {
@@ -357,6 +397,12 @@ std::vector<InputParameterDesc> ParseInputParameters(const D3D12_SHADER_DESC& de
                 input.format = gli::format::FORMAT_RGBA32_SINT_PACK32;
             } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT32) {
                 input.format = gli::format::FORMAT_RGBA32_SFLOAT_PACK32;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_UINT16) {
+                input.format = gli::format::FORMAT_RGBA16_UINT_PACK16;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_SINT16) {
+                input.format = gli::format::FORMAT_RGBA16_SINT_PACK16;
+            } else if (param_desc.ComponentType == D3D_REGISTER_COMPONENT_FLOAT16) {
+                input.format = gli::format::FORMAT_RGBA16_SFLOAT_PACK16;
             }
         }
     }
@@ -459,6 +505,11 @@ const std::vector<OutputParameterDesc>& DXILReflection::GetOutputParameters() co
     return m_output_parameters;
 }
 
+const std::vector<SpecializationConstantDesc>& DXILReflection::GetSpecializationConstants() const
+{
+    return m_specialization_constants;
+}
+
 const ShaderFeatureInfo& DXILReflection::GetShaderFeatureInfo() const
 {
     return m_shader_feature_info;
@@ -15,6 +15,7 @@ public:
     const std::vector<VariableLayout>& GetVariableLayouts() const override;
     const std::vector<InputParameterDesc>& GetInputParameters() const override;
     const std::vector<OutputParameterDesc>& GetOutputParameters() const override;
+    const std::vector<SpecializationConstantDesc>& GetSpecializationConstants() const override;
     const ShaderFeatureInfo& GetShaderFeatureInfo() const override;
 
 private:
@@ -29,5 +30,6 @@ private:
     std::vector<VariableLayout> m_layouts;
     std::vector<InputParameterDesc> m_input_parameters;
     std::vector<OutputParameterDesc> m_output_parameters;
+    std::vector<SpecializationConstantDesc> m_specialization_constants;
     ShaderFeatureInfo m_shader_feature_info = {};
 };
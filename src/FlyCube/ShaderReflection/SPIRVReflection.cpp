@@ -1,7 +1,11 @@
 #include "ShaderReflection/SPIRVReflection.h"
 
+#include "ShaderReflection/SPIRVScanner.h"
 #include "Utilities/Common.h"
 
+#include <algorithm>
+#include <map>
+
 namespace {
 
 ShaderKind ConvertShaderKind(spv::ExecutionModel execution_model)
@@ -79,6 +83,36 @@ std::vector<InputParameterDesc> ParseInputParameters(const spirv_cross::Compiler
             } else if (type.vecsize == 4) {
                 input.format = gli::format::FORMAT_RGBA32_SINT_PACK32;
             }
+        } else if (type.basetype == spirv_cross::SPIRType::Half) {
+            if (type.vecsize == 1) {
+                input.format = gli::format::FORMAT_R16_SFLOAT_PACK16;
+            } else if (type.vecsize == 2) {
+                input.format = gli::format::FORMAT_RG16_SFLOAT_PACK16;
+            } else if (type.vecsize == 3) {
+                input.format = gli::format::FORMAT_RGB16_SFLOAT_PACK16;
+            } else if (type.vecsize == 4) {
+                input.format = gli::format::FORMAT_RGBA16_SFLOAT_PACK16;
+            }
+        } else if (type.basetype == spirv_cross::SPIRType::UShort) {
+            if (type.vecsize == 1) {
+                input.format = gli::format::FORMAT_R16_UINT_PACK16;
+            } else if (type.vecsize == 2) {
+                input.format = gli::format::FORMAT_RG16_UINT_PACK16;
+            } else if (type.vecsize == 3) {
+                input.format = gli::format::FORMAT_RGB16_UINT_PACK16;
+            } else if (type.vecsize == 4) {
+                input.format = gli::format::FORMAT_RGBA16_UINT_PACK16;
+            }
+        } else if (type.basetype == spirv_cross::SPIRType::Short) {
+            if (type.vecsize == 1) {
+                input.format = gli::format::FORMAT_R16_SINT_PACK16;
+            } else if (type.vecsize == 2) {
+                input.format = gli::format::FORMAT_RG16_SINT_PACK16;
+            } else if (type.vecsize == 3) {
+                input.format = gli::format::FORMAT_RGB16_SINT_PACK16;
+            } else if (type.vecsize == 4) {
+                input.format = gli::format::FORMAT_RGBA16_SINT_PACK16;
+            }
         }
     }
     return input_parameters;
@@ -251,6 +285,11 @@ ResourceBindingDesc GetBindingDesc(const spirv_cross::CompilerHLSL& compiler, co
     }
     desc.dimension = GetViewDimension(type);
     desc.return_type = GetReturnType(compiler, type);
+    if (type.storage == spv::StorageClassPushConstant) {
+        decltype(auto) base_type = compiler.get_type(resource.base_type_id);
+        desc.is_root_constant = true;
+        desc.count = Align(compiler.get_declared_struct_size(base_type), sizeof(uint32_t)) / sizeof(uint32_t);
+    }
     switch (desc.type) {
     case ViewType::kStructuredBuffer:
     case ViewType::kRWStructuredBuffer: {
@@ -325,39 +364,118 @@ VariableLayout GetBufferLayout(ViewType view_type,
     return layout;
 }
 
+std::vector<SpecializationConstantDesc> ParseSpecializationConstants(const spirv_cross::CompilerHLSL& compiler)
+{
+    std::vector<SpecializationConstantDesc> specialization_constants;
+    for (const auto& constant : compiler.get_specialization_constants()) {
+        decltype(auto) value = compiler.get_constant(constant.id);
+        decltype(auto) type = compiler.get_type(value.constant_type);
+        SpecializationConstantDesc desc = {};
+        desc.name = compiler.get_name(constant.id);
+        desc.id = constant.constant_id;
+        desc.default_value = value.scalar();
+        switch (type.basetype) {
+        case spirv_cross::SPIRType::BaseType::Float:
+            desc.type = VariableType::kFloat;
+            break;
+        case spirv_cross::SPIRType::BaseType::Int:
+            desc.type = VariableType::kInt;
+            break;
+        case spirv_cross::SPIRType::BaseType::UInt:
+            desc.type = VariableType::kUint;
+            break;
+        case spirv_cross::SPIRType::BaseType::Boolean:
+            desc.type = VariableType::kBool;
+            break;
+        default:
+            assert(false);
+            continue;
+        }
+        desc.size = desc.type == VariableType::kBool ? sizeof(uint32_t) : type.width / 8;
+        if (desc.size != sizeof(uint16_t) && desc.size != sizeof(uint32_t)) {
+            continue;
+        }
+        specialization_constants.emplace_back(std::move(desc));
+    }
+    std::sort(specialization_constants.begin(), specialization_constants.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.id < rhs.id; });
+    return specialization_constants;
+}
+
+template <typename Func>
+void EnumerateBindingResources(const spirv_cross::ShaderResources& resources, Func&& func)
+{
+    for (const auto* list : { &resources.uniform_buffers, &resources.storage_buffers, &resources.storage_images,
+                              &resources.separate_images, &resources.separate_samplers, &resources.atomic_counters,
+                              &resources.acceleration_structures, &resources.push_constant_buffers }) {
+        for (const auto& resource : *list) {
+            func(resource);
+        }
+    }
+}
+
 void ParseBindings(const spirv_cross::CompilerHLSL& compiler,
                    std::vector<ResourceBindingDesc>& bindings,
-                   std::vector<VariableLayout>& layouts)
+                   std::vector<uint32_t>& binding_ids)
 {
     spirv_cross::ShaderResources resources = compiler.get_shader_resources();
-    auto enumerate_resources = [&](const spirv_cross::SmallVector<spirv_cross::Resource>& resources) {
-        for (const auto& resource : resources) {
-            bindings.emplace_back(GetBindingDesc(compiler, resource));
-            layouts.emplace_back(GetBufferLayout(bindings.back().type, compiler, resource));
+    EnumerateBindingResources(resources, [&](const spirv_cross::Resource& resource) {
+        bindings.emplace_back(GetBindingDesc(compiler, resource));
+        binding_ids.emplace_back(resource.id);
+    });
+}
+
+std::vector<VariableLayout> ParseLayouts(const std::vector<uint32_t>& blob,
+                                         const std::vector<ResourceBindingDesc>& bindings,
+                                         const std::vector<uint32_t>& binding_ids)
+{
+    std::vector<VariableLayout> layouts(bindings.size());
+    bool has_constant_buffers = std::any_of(bindings.begin(), bindings.end(), [](const auto& binding) {
+        return binding.type == ViewType::kConstantBuffer;
+    });
+    if (!has_constant_buffers) {
+        return layouts;
+    }
+
+    spirv_cross::CompilerHLSL compiler(blob);
+    std::map<uint32_t, spirv_cross::Resource> resources;
+    EnumerateBindingResources(compiler.get_shader_resources(),
+                              [&](const spirv_cross::Resource& resource) { resources.emplace(resource.id, resource); });
+    for (size_t i = 0; i < bindings.size(); ++i) {
+        auto it = resources.find(binding_ids[i]);
+        if (it != resources.end()) {
+            layouts[i] = GetBufferLayout(bindings[i].type, compiler, it->second);
         }
-    };
-    enumerate_resources(resources.uniform_buffers);
-    enumerate_resources(resources.storage_buffers);
-    enumerate_resources(resources.storage_images);
-    enumerate_resources(resources.separate_images);
-    enumerate_resources(resources.separate_samplers);
-    enumerate_resources(resources.atomic_counters);
-    enumerate_resources(resources.acceleration_structures);
+    }
+    return layouts;
 }
 
 } // namespace
 
-SPIRVReflection::SPIRVReflection(const void* data, size_t size)
+SPIRVReflection::SPIRVReflection(const void* data, size_t size, bool use_scanner)
     : m_blob((const uint32_t*)data, (const uint32_t*)data + size / sizeof(uint32_t))
 {
+    SPIRVScanResult scan_result;
+    if (use_scanner && ScanSPIRV(m_blob.data(), m_blob.size(), scan_result)) {
+        m_entry_points = std::move(scan_result.entry_points);
+        m_bindings = std::move(scan_result.bindings);
+        m_binding_ids = std::move(scan_result.binding_ids);
+        m_input_parameters = std::move(scan_result.input_parameters);
+        m_output_parameters = std::move(scan_result.output_parameters);
+        m_specialization_constants = std::move(scan_result.specialization_constants);
+        m_shader_feature_info = scan_result.shader_feature_info;
+        return;
+    }
+
     spirv_cross::CompilerHLSL compiler(m_blob);
     auto entry_points = compiler.get_entry_points_and_stages();
     for (const auto& entry_point : entry_points) {
         m_entry_points.push_back({ entry_point.name.c_str(), ConvertShaderKind(entry_point.execution_model) });
     }
-    ParseBindings(compiler, m_bindings, m_layouts);
+    ParseBindings(compiler, m_bindings, m_binding_ids);
     m_input_parameters = ParseInputParameters(compiler);
     m_output_parameters = ParseOutputParameters(compiler);
+    m_specialization_constants = ParseSpecializationConstants(compiler);
 
     for (uint32_t i = 0; i < m_shader_feature_info.numthreads.size(); ++i) {
         m_shader_feature_info.numthreads[i] = compiler.get_execution_mode_argument(spv::ExecutionModeLocalSize, i);
@@ -376,6 +494,7 @@ const std::vector<ResourceBindingDesc>& SPIRVReflection::GetBindings() const
 
 const std::vector<VariableLayout>& SPIRVReflection::GetVariableLayouts() const
 {
+    std::call_once(m_layouts_once, [&] { m_layouts = ParseLayouts(m_blob, m_bindings, m_binding_ids); });
     return m_layouts;
 }
 
@@ -389,6 +508,11 @@ const std::vector<OutputParameterDesc>& SPIRVReflection::GetOutputParameters() c
     return m_output_parameters;
 }
 
+const std::vector<SpecializationConstantDesc>& SPIRVReflection::GetSpecializationConstants() const
+{
+    return m_specialization_constants;
+}
+
 const ShaderFeatureInfo& SPIRVReflection::GetShaderFeatureInfo() const
 {
     return m_shader_feature_info;
@@ -3,25 +3,31 @@
 
 #include <spirv_hlsl.hpp>
 
+#include <mutex>
 #include <string>
 #include <vector>
 
 class SPIRVReflection : public ShaderReflection {
 public:
-    SPIRVReflection(const void* data, size_t size);
+    // The fast path is ScanSPIRV, spirv-cross is used for variable layouts and for modules the scanner rejects
+    SPIRVReflection(const void* data, size_t size, bool use_scanner = true);
     const std::vector<EntryPoint>& GetEntryPoints() const override;
     const std::vector<ResourceBindingDesc>& GetBindings() const override;
     const std::vector<VariableLayout>& GetVariableLayouts() const override;
     const std::vector<InputParameterDesc>& GetInputParameters() const override;
     const std::vector<OutputParameterDesc>& GetOutputParameters() const override;
+    const std::vector<SpecializationConstantDesc>& GetSpecializationConstants() const override;
     const ShaderFeatureInfo& GetShaderFeatureInfo() const override;
 
 private:
     std::vector<uint32_t> m_blob;
     std::vector<EntryPoint> m_entry_points;
     std::vector<ResourceBindingDesc> m_bindings;
-    std::vector<VariableLayout> m_layouts;
+    std::vector<uint32_t> m_binding_ids;
+    mutable std::once_flag m_layouts_once;
+    mutable std::vector<VariableLayout> m_layouts;
     std::vector<InputParameterDesc> m_input_parameters;
     std::vector<OutputParameterDesc> m_output_parameters;
+    std::vector<SpecializationConstantDesc> m_specialization_constants;
     ShaderFeatureInfo m_shader_feature_info = {};
 };
@@ -0,0 +1,785 @@
+#include "ShaderReflection/SPIRVScanner.h"
+
+#include <spirv.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+constexpr uint32_t kSPIRVHeaderSize = 5;
+constexpr uint32_t kSPIRVVersion1_4 = 0x10400;
+constexpr uint32_t kMaxStructDepth = 16;
+
+enum IdFlags : uint32_t {
+    kBlock = 1 << 0,
+    kBufferBlock = 1 << 1,
+    kNonWritable = 1 << 2,
+    kBuiltIn = 1 << 3,
+    kBuiltInMember = 1 << 4,
+    kEntryPointInterface = 1 << 5,
+    kSizeMemberRowMajor = 1 << 6,
+    kSizeMemberColMajor = 1 << 7,
+    kSpecId = 1 << 8,
+};
+
+// Categories in the order ParseBindings enumerates spirv-cross resources
+enum class ResourceCategory : uint32_t {
+    kUniformBuffer,
+    kStorageBuffer,
+    kStorageImage,
+    kSeparateImage,
+    kSeparateSampler,
+    kAccelerationStructure,
+    kPushConstantBuffer,
+    kInput,
+    kOutput,
+    kNone,
+};
+
+struct IdInfo {
+    // Word offsets of the defining instruction and of the OpName/semantic strings, 0 if absent
+    uint32_t instruction;
+    uint32_t name;
+    uint32_t semantic;
+    uint32_t binding;
+    uint32_t set;
+    uint32_t location;
+    uint32_t array_stride;
+    uint32_t spec_id;
+    uint32_t non_writable_members;
+    uint32_t flags;
+    // The member with the highest offset of a struct, spirv-cross derives the declared struct size from it
+    uint32_t size_member;
+    uint32_t size_member_offset;
+    uint32_t size_member_matrix_stride;
+};
+
+class SPIRVModule {
+public:
+    SPIRVModule(const uint32_t* words, size_t word_count)
+        : m_words(words)
+        , m_word_count(word_count)
+    {
+    }
+
+    bool Scan(SPIRVScanResult& result);
+
+private:
+    bool IsId(uint32_t id) const
+    {
+        return id < m_ids.size();
+    }
+
+    bool IsString(uint32_t offset, uint32_t end) const
+    {
+        return offset < end && memchr(&m_words[offset], 0, (end - offset) * sizeof(uint32_t)) != nullptr;
+    }
+
+    const char* GetString(uint32_t offset) const
+    {
+        return offset ? reinterpret_cast<const char*>(&m_words[offset]) : "";
+    }
+
+    spv::Op GetOpcode(uint32_t id) const
+    {
+        if (!IsId(id) || !m_ids[id].instruction) {
+            return spv::OpNop;
+        }
+        return static_cast<spv::Op>(m_words[m_ids[id].instruction] & spv::OpCodeMask);
+    }
+
+    uint32_t GetOperandCount(uint32_t id) const
+    {
+        if (GetOpcode(id) == spv::OpNop) {
+            return 0;
+        }
+        return (m_words[m_ids[id].instruction] >> spv::WordCountShift) - 1;
+    }
+
+    // Operands are counted after the opcode word, so the result id of a type is operand 0
+    uint32_t GetOperand(uint32_t id, uint32_t index) const
+    {
+        if (index >= GetOperandCount(id)) {
+            return 0;
+        }
+        return m_words[m_ids[id].instruction + 1 + index];
+    }
+
+    bool ScanInstruction(spv::Op opcode, uint32_t offset, uint32_t operand_count);
+    bool AddVariable(uint32_t id, ResourceCategory& category);
+    bool AddBinding(uint32_t id, uint32_t type, SPIRVScanResult& result) const;
+    bool AddInputParameter(uint32_t id, uint32_t type, SPIRVScanResult& result) const;
+    bool GetArrayCount(uint32_t& type, uint32_t& count) const;
+    bool GetStructSize(uint32_t type, uint32_t& size, uint32_t depth = 0) const;
+    bool AddSpecializationConstant(uint32_t id, SPIRVScanResult& result) const;
+
+    const uint32_t* m_words;
+    size_t m_word_count;
+    std::vector<IdInfo> m_ids;
+    std::vector<uint32_t> m_variables;
+    std::vector<uint32_t> m_spec_constants;
+    uint32_t m_entry_point_count = 0;
+    uint32_t m_default_entry_point = 0;
+    std::array<uint32_t, 3> m_numthreads = {};
+};
+
+bool ConvertShaderKind(uint32_t execution_model, ShaderKind& kind)
+{
+    switch (execution_model) {
+    case spv::ExecutionModelVertex:
+        kind = ShaderKind::kVertex;
+        return true;
+    case spv::ExecutionModelFragment:
+        kind = ShaderKind::kPixel;
+        return true;
+    case spv::ExecutionModelGeometry:
+        kind = ShaderKind::kGeometry;
+        return true;
+    case spv::ExecutionModelGLCompute:
+        kind = ShaderKind::kCompute;
+        return true;
+    case spv::ExecutionModelRayGenerationKHR:
+        kind = ShaderKind::kRayGeneration;
+        return true;
+    case spv::ExecutionModelIntersectionKHR:
+        kind = ShaderKind::kIntersection;
+        return true;
+    case spv::ExecutionModelAnyHitKHR:
+        kind = ShaderKind::kAnyHit;
+        return true;
+    case spv::ExecutionModelClosestHitKHR:
+        kind = ShaderKind::kClosestHit;
+        return true;
+    case spv::ExecutionModelMissKHR:
+        kind = ShaderKind::kMiss;
+        return true;
+    case spv::ExecutionModelCallableKHR:
+        kind = ShaderKind::kCallable;
+        return true;
+    case spv::ExecutionModelTaskEXT:
+        kind = ShaderKind::kAmplification;
+        return true;
+    case spv::ExecutionModelMeshEXT:
+        kind = ShaderKind::kMesh;
+        return true;
+    default:
+        return false;
+    }
+}
+
+gli::format GetInputFormat(spv::Op opcode, uint32_t width, uint32_t signedness, uint32_t vecsize)
+{
+    // Indexed by [width == 16][vecsize - 1]
+    static constexpr gli::format kFloatFormats[2][4] = {
+        {
+            gli::format::FORMAT_R32_SFLOAT_PACK32,
+            gli::format::FORMAT_RG32_SFLOAT_PACK32,
+            gli::format::FORMAT_RGB32_SFLOAT_PACK32,
+            gli::format::FORMAT_RGBA32_SFLOAT_PACK32,
+        },
+        {
+            gli::format::FORMAT_R16_SFLOAT_PACK16,
+            gli::format::FORMAT_RG16_SFLOAT_PACK16,
+            gli::format::FORMAT_RGB16_SFLOAT_PACK16,
+            gli::format::FORMAT_RGBA16_SFLOAT_PACK16,
+        },
+    };
+    static constexpr gli::format kUintFormats[2][4] = {
+        {
+            gli::format::FORMAT_R32_UINT_PACK32,
+            gli::format::FORMAT_RG32_UINT_PACK32,
+            gli::format::FORMAT_RGB32_UINT_PACK32,
+            gli::format::FORMAT_RGBA32_UINT_PACK32,
+        },
+        {
+            gli::format::FORMAT_R16_UINT_PACK16,
+            gli::format::FORMAT_RG16_UINT_PACK16,
+            gli::format::FORMAT_RGB16_UINT_PACK16,
+            gli::format::FORMAT_RGBA16_UINT_PACK16,
+        },
+    };
+    static constexpr gli::format kSintFormats[2][4] = {
+        {
+            gli::format::FORMAT_R32_SINT_PACK32,
+            gli::format::FORMAT_RG32_SINT_PACK32,
+            gli::format::FORMAT_RGB32_SINT_PACK32,
+            gli::format::FORMAT_RGBA32_SINT_PACK32,
+        },
+        {
+            gli::format::FORMAT_R16_SINT_PACK16,
+            gli::format::FORMAT_RG16_SINT_PACK16,
+            gli::format::FORMAT_RGB16_SINT_PACK16,
+            gli::format::FORMAT_RGBA16_SINT_PACK16,
+        },
+    };
+    if ((width != 32 && width != 16) || vecsize < 1 || vecsize > 4) {
+        return gli::format::FORMAT_UNDEFINED;
+    }
+    bool is_16bit = width == 16;
+    if (opcode == spv::OpTypeFloat) {
+        return kFloatFormats[is_16bit][vecsize - 1];
+    } else if (opcode == spv::OpTypeInt) {
+        return signedness ? kSintFormats[is_16bit][vecsize - 1] : kUintFormats[is_16bit][vecsize - 1];
+    }
+    return gli::format::FORMAT_UNDEFINED;
+}
+
+bool SPIRVModule::Scan(SPIRVScanResult& result)
+{
+    if (m_word_count < kSPIRVHeaderSize || m_words[0] != spv::MagicNumber) {
+        return false;
+    }
+    // Every id is defined by an instruction, so the bound can't exceed the module size
+    if (m_words[3] > m_word_count) {
+        return false;
+    }
+    m_ids.assign(m_words[3], {});
+
+    // Names, decorations, types and global variables all precede the first function
+    for (uint32_t offset = kSPIRVHeaderSize; offset < m_word_count;) {
+        uint32_t word_count = m_words[offset] >> spv::WordCountShift;
+        spv::Op opcode = static_cast<spv::Op>(m_words[offset] & spv::OpCodeMask);
+        if (word_count == 0 || word_count > m_word_count - offset) {
+            return false;
+        }
+        if (opcode == spv::OpFunction) {
+            break;
+        }
+        if (opcode == spv::OpEntryPoint) {
+            if (word_count < 4 || !IsId(m_words[offset + 2]) || !IsString(offset + 3, offset + word_count)) {
+                return false;
+            }
+            decltype(auto) entry_point = result.entry_points.emplace_back();
+            entry_point.name = GetString(offset + 3);
+            if (!ConvertShaderKind(m_words[offset + 1], entry_point.kind)) {
+                return false;
+            }
+            if (m_entry_point_count++ == 0) {
+                m_default_entry_point = m_words[offset + 2];
+                uint32_t interface_offset = offset + 3 + entry_point.name.size() / sizeof(uint32_t) + 1;
+                for (uint32_t i = interface_offset; i < offset + word_count; ++i) {
+                    if (!IsId(m_words[i])) {
+                        return false;
+                    }
+                    m_ids[m_words[i]].flags |= kEntryPointInterface;
+                }
+            }
+        } else if (!ScanInstruction(opcode, offset, word_count - 1)) {
+            return false;
+        }
+        offset += word_count;
+    }
+
+    uint32_t version = m_words[1];
+    std::vector<std::pair<ResourceCategory, uint32_t>> resources;
+    resources.reserve(m_variables.size());
+    for (uint32_t id : m_variables) {
+        uint32_t storage = GetOperand(id, 2);
+        // Matches the filtering of spirv_cross::Compiler::get_shader_resources
+        bool is_interface = storage == spv::StorageClassInput || storage == spv::StorageClassOutput;
+        bool is_active = m_ids[id].flags & kEntryPointInterface;
+        if (version < kSPIRVVersion1_4 && (!is_interface || m_entry_point_count <= 1)) {
+            is_active = true;
+        }
+        ResourceCategory category = ResourceCategory::kNone;
+        if (is_active && !AddVariable(id, category)) {
+            return false;
+        }
+        if (category != ResourceCategory::kNone) {
+            resources.emplace_back(category, id);
+        }
+    }
+    std::stable_sort(resources.begin(), resources.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+    for (const auto& [category, id] : resources) {
+        uint32_t type = GetOperand(GetOperand(id, 0), 2);
+        if (category == ResourceCategory::kInput) {
+            if (!AddInputParameter(id, type, result)) {
+                return false;
+            }
+        } else if (category == ResourceCategory::kOutput) {
+            result.output_parameters.push_back({ m_ids[id].location });
+        } else if (!AddBinding(id, type, result)) {
+            return false;
+        }
+    }
+
+    for (uint32_t id : m_spec_constants) {
+        if ((m_ids[id].flags & kSpecId) && !AddSpecializationConstant(id, result)) {
+            return false;
+        }
+    }
+    std::sort(result.specialization_constants.begin(), result.specialization_constants.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.id < rhs.id; });
+
+    result.shader_feature_info.numthreads = m_numthreads;
+    return true;
+}
+
+bool SPIRVModule::ScanInstruction(spv::Op opcode, uint32_t offset, uint32_t operand_count)
+{
+    const uint32_t* operands = &m_words[offset + 1];
+    uint32_t end = offset + 1 + operand_count;
+    switch (opcode) {
+    case spv::OpName:
+        if (operand_count < 2 || !IsId(operands[0]) || !IsString(offset + 2, end)) {
+            return false;
+        }
+        m_ids[operands[0]].name = offset + 2;
+        return true;
+    case spv::OpExecutionMode:
+        if (operand_count < 2) {
+            return false;
+        }
+        if (operands[0] != m_default_entry_point || m_entry_point_count == 0) {
+            return true;
+        }
+        if (operands[1] == spv::ExecutionModeLocalSizeId) {
+            return false;
+        }
+        if (operands[1] == spv::ExecutionModeLocalSize) {
+            if (operand_count < 5) {
+                return false;
+            }
+            m_numthreads = { operands[2], operands[3], operands[4] };
+        }
+        return true;
+    case spv::OpDecorate: {
+        if (operand_count < 2 || !IsId(operands[0])) {
+            return false;
+        }
+        decltype(auto) info = m_ids[operands[0]];
+        uint32_t value = operand_count > 2 ? operands[2] : 0;
+        switch (operands[1]) {
+        case spv::DecorationBlock:
+            info.flags |= kBlock;
+            break;
+        case spv::DecorationBufferBlock:
+            info.flags |= kBufferBlock;
+            break;
+        case spv::DecorationNonWritable:
+            info.flags |= kNonWritable;
+            break;
+        case spv::DecorationBuiltIn:
+            info.flags |= kBuiltIn;
+            break;
+        case spv::DecorationBinding:
+            info.binding = value;
+            break;
+        case spv::DecorationDescriptorSet:
+            info.set = value;
+            break;
+        case spv::DecorationLocation:
+            info.location = value;
+            break;
+        case spv::DecorationArrayStride:
+            info.array_stride = value;
+            break;
+        case spv::DecorationSpecId:
+            info.spec_id = value;
+            info.flags |= kSpecId;
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+    case spv::OpMemberDecorate: {
+        if (operand_count < 3 || !IsId(operands[0])) {
+            return false;
+        }
+        decltype(auto) info = m_ids[operands[0]];
+        uint32_t member = operands[1];
+        uint32_t value = operand_count > 3 ? operands[3] : 0;
+        switch (operands[2]) {
+        case spv::DecorationNonWritable:
+            ++info.non_writable_members;
+            break;
+        case spv::DecorationBuiltIn:
+            info.flags |= kBuiltInMember;
+            break;
+        case spv::DecorationOffset:
+            if (value > info.size_member_offset) {
+                info.size_member = member;
+                info.size_member_offset = value;
+                info.size_member_matrix_stride = 0;
+                info.flags &= ~(kSizeMemberRowMajor | kSizeMemberColMajor);
+            }
+            break;
+        case spv::DecorationMatrixStride:
+            if (member == info.size_member) {
+                info.size_member_matrix_stride = value;
+            }
+            break;
+        case spv::DecorationRowMajor:
+            if (member == info.size_member) {
+                info.flags |= kSizeMemberRowMajor;
+            }
+            break;
+        case spv::DecorationColMajor:
+            if (member == info.size_member) {
+                info.flags |= kSizeMemberColMajor;
+            }
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+    case spv::OpDecorateString:
+        if (operand_count < 3 || !IsId(operands[0]) || !IsString(offset + 3, end)) {
+            return false;
+        }
+        if (operands[1] == spv::DecorationHlslSemanticGOOGLE) {
+            m_ids[operands[0]].semantic = offset + 3;
+        }
+        return true;
+    case spv::OpTypeVoid:
+    case spv::OpTypeBool:
+    case spv::OpTypeInt:
+    case spv::OpTypeFloat:
+    case spv::OpTypeVector:
+    case spv::OpTypeMatrix:
+    case spv::OpTypeImage:
+    case spv::OpTypeSampler:
+    case spv::OpTypeSampledImage:
+    case spv::OpTypeArray:
+    case spv::OpTypeRuntimeArray:
+    case spv::OpTypeStruct:
+    case spv::OpTypePointer:
+    case spv::OpTypeAccelerationStructureKHR:
+        if (operand_count < 1 || !IsId(operands[0])) {
+            return false;
+        }
+        m_ids[operands[0]].instruction = offset;
+        return true;
+    case spv::OpConstant:
+        if (operand_count < 3 || !IsId(operands[1])) {
+            return false;
+        }
+        m_ids[operands[1]].instruction = offset;
+        return true;
+    case spv::OpSpecConstant:
+    case spv::OpSpecConstantTrue:
+    case spv::OpSpecConstantFalse:
+        if (operand_count < (opcode == spv::OpSpecConstant ? 3 : 2) || !IsId(operands[1])) {
+            return false;
+        }
+        m_ids[operands[1]].instruction = offset;
+        m_spec_constants.push_back(operands[1]);
+        return true;
+    case spv::OpVariable:
+        if (operand_count < 3 || !IsId(operands[1])) {
+            return false;
+        }
+        m_ids[operands[1]].instruction = offset;
+        m_variables.push_back(operands[1]);
+        return true;
+    default:
+        return true;
+    }
+}
+
+bool SPIRVModule::AddVariable(uint32_t id, ResourceCategory& category)
+{
+    uint32_t pointer = GetOperand(id, 0);
+    if (GetOpcode(pointer) != spv::OpTypePointer) {
+        return false;
+    }
+    uint32_t type = GetOperand(pointer, 2);
+    uint32_t count = 1;
+    if (!GetArrayCount(type, count)) {
+        return false;
+    }
+    spv::Op opcode = GetOpcode(type);
+    if ((m_ids[id].flags & kBuiltIn) || (m_ids[type].flags & kBuiltInMember)) {
+        return true;
+    }
+
+    switch (GetOperand(id, 2)) {
+    case spv::StorageClassInput:
+        category = ResourceCategory::kInput;
+        return true;
+    case spv::StorageClassOutput:
+        category = ResourceCategory::kOutput;
+        return true;
+    case spv::StorageClassUniform:
+        if (m_ids[type].flags & kBlock) {
+            category = ResourceCategory::kUniformBuffer;
+        } else if (m_ids[type].flags & kBufferBlock) {
+            category = ResourceCategory::kStorageBuffer;
+        }
+        return true;
+    case spv::StorageClassStorageBuffer:
+        category = ResourceCategory::kStorageBuffer;
+        return true;
+    case spv::StorageClassPushConstant:
+        if (opcode == spv::OpTypeStruct) {
+            category = ResourceCategory::kPushConstantBuffer;
+        }
+        return true;
+    case spv::StorageClassUniformConstant:
+        if (opcode == spv::OpTypeImage) {
+            uint32_t dim = GetOperand(type, 2);
+            uint32_t sampled = GetOperand(type, 6);
+            if (dim == spv::DimSubpassData) {
+                return true;
+            }
+            if (sampled == 2) {
+                category = ResourceCategory::kStorageImage;
+            } else if (sampled == 1) {
+                category = ResourceCategory::kSeparateImage;
+            }
+        } else if (opcode == spv::OpTypeSampler) {
+            category = ResourceCategory::kSeparateSampler;
+        } else if (opcode == spv::OpTypeAccelerationStructureKHR) {
+            category = ResourceCategory::kAccelerationStructure;
+        }
+        return true;
+    case spv::StorageClassAtomicCounter:
+        return false;
+    default:
+        return true;
+    }
+}
+
+bool SPIRVModule::GetArrayCount(uint32_t& type, uint32_t& count) const
+{
+    // spirv-cross reports the innermost dimension of nested arrays
+    for (spv::Op opcode = GetOpcode(type); opcode == spv::OpTypeArray || opcode == spv::OpTypeRuntimeArray;
+         opcode = GetOpcode(type)) {
+        if (opcode == spv::OpTypeArray) {
+            uint32_t length = GetOperand(type, 2);
+            if (GetOpcode(length) != spv::OpConstant) {
+                return false;
+            }
+            count = GetOperand(length, 2);
+        } else {
+            count = 0;
+        }
+        type = GetOperand(type, 1);
+    }
+    return IsId(type) && m_ids[type].instruction;
+}
+
+bool SPIRVModule::AddBinding(uint32_t id, uint32_t type, SPIRVScanResult& result) const
+{
+    uint32_t storage = GetOperand(GetOperand(id, 0), 1);
+    uint32_t count = 1;
+    GetArrayCount(type, count);
+
+    ResourceBindingDesc desc = {};
+    desc.name = GetString(m_ids[id].name);
+    desc.slot = m_ids[id].binding;
+    desc.space = m_ids[id].set;
+    desc.count = count ? count : std::numeric_limits<uint32_t>::max();
+    desc.dimension = ViewDimension::kUnknown;
+    desc.return_type = ReturnType::kUnknown;
+
+    switch (GetOpcode(type)) {
+    case spv::OpTypeAccelerationStructureKHR:
+        desc.type = ViewType::kAccelerationStructure;
+        break;
+    case spv::OpTypeSampler:
+        desc.type = ViewType::kSampler;
+        break;
+    case spv::OpTypeImage: {
+        bool is_readonly = GetOperand(type, 6) != 2;
+        bool is_arrayed = GetOperand(type, 4);
+        bool is_ms = GetOperand(type, 5);
+        switch (GetOperand(type, 2)) {
+        case spv::Dim1D:
+            desc.dimension = is_arrayed ? ViewDimension::kTexture1DArray : ViewDimension::kTexture1D;
+            break;
+        case spv::Dim2D:
+            if (is_ms) {
+                desc.dimension = is_arrayed ? ViewDimension::kTexture2DMSArray : ViewDimension::kTexture2DMS;
+            } else {
+                desc.dimension = is_arrayed ? ViewDimension::kTexture2DArray : ViewDimension::kTexture2D;
+            }
+            break;
+        case spv::Dim3D:
+            desc.dimension = ViewDimension::kTexture3D;
+            break;
+        case spv::DimCube:
+            desc.dimension = is_arrayed ? ViewDimension::kTextureCubeArray : ViewDimension::kTextureCube;
+            break;
+        case spv::DimBuffer:
+            desc.dimension = ViewDimension::kBuffer;
+            break;
+        default:
+            return false;
+        }
+        if (desc.dimension == ViewDimension::kBuffer) {
+            desc.type = is_readonly ? ViewType::kBuffer : ViewType::kRWBuffer;
+        } else {
+            desc.type = is_readonly ? ViewType::kTexture : ViewType::kRWTexture;
+        }
+
+        uint32_t sampled_type = GetOperand(type, 1);
+        uint32_t width = GetOperand(sampled_type, 1);
+        if (GetOpcode(sampled_type) == spv::OpTypeFloat && width == 32) {
+            desc.return_type = ReturnType::kFloat;
+        } else if (GetOpcode(sampled_type) == spv::OpTypeFloat && width == 64) {
+            desc.return_type = ReturnType::kDouble;
+        } else if (GetOpcode(sampled_type) == spv::OpTypeInt && width == 32) {
+            desc.return_type = GetOperand(sampled_type, 2) ? ReturnType::kInt : ReturnType::kUint;
+        } else {
+            return false;
+        }
+        break;
+    }
+    case spv::OpTypeStruct: {
+        desc.dimension = ViewDimension::kBuffer;
+        if (storage == spv::StorageClassPushConstant) {
+            uint32_t size = 0;
+            if (!GetStructSize(type, size)) {
+                return false;
+            }
+            desc.type = ViewType::kConstantBuffer;
+            desc.count = (size + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+            desc.is_root_constant = true;
+            break;
+        } else if (storage == spv::StorageClassUniform) {
+            desc.type = ViewType::kConstantBuffer;
+            break;
+        } else if (storage != spv::StorageClassStorageBuffer) {
+            return false;
+        }
+
+        uint32_t member_count = GetOperandCount(type) - 1;
+        bool is_readonly = (m_ids[id].flags & kNonWritable) ||
+                           (member_count && m_ids[type].non_writable_members >= member_count);
+        desc.type = is_readonly ? ViewType::kStructuredBuffer : ViewType::kRWStructuredBuffer;
+
+        uint32_t last_member = GetOperand(type, member_count);
+        if (!member_count || GetOpcode(last_member) != spv::OpTypeRuntimeArray ||
+            GetOpcode(GetOperand(last_member, 1)) == spv::OpTypeArray || !m_ids[last_member].array_stride) {
+            return false;
+        }
+        desc.structure_stride = m_ids[last_member].array_stride;
+        break;
+    }
+    default:
+        return false;
+    }
+
+    result.bindings.emplace_back(std::move(desc));
+    result.binding_ids.push_back(id);
+    return true;
+}
+
+bool SPIRVModule::GetStructSize(uint32_t type, uint32_t& size, uint32_t depth) const
+{
+    if (GetOpcode(type) != spv::OpTypeStruct || GetOperandCount(type) < 2 || depth > kMaxStructDepth) {
+        return false;
+    }
+
+    const IdInfo& info = m_ids[type];
+    uint32_t member = GetOperand(type, info.size_member + 1);
+    uint32_t member_size = 0;
+    switch (GetOpcode(member)) {
+    case spv::OpTypeInt:
+    case spv::OpTypeFloat:
+        member_size = GetOperand(member, 1) / 8;
+        break;
+    case spv::OpTypeVector:
+        member_size = GetOperand(GetOperand(member, 1), 1) / 8 * GetOperand(member, 2);
+        break;
+    case spv::OpTypeMatrix:
+        if (info.flags & kSizeMemberRowMajor) {
+            member_size = info.size_member_matrix_stride * GetOperand(GetOperand(member, 1), 2);
+        } else if (info.flags & kSizeMemberColMajor) {
+            member_size = info.size_member_matrix_stride * GetOperand(member, 2);
+        }
+        break;
+    case spv::OpTypeArray: {
+        uint32_t length = GetOperand(member, 2);
+        if (GetOpcode(length) == spv::OpConstant) {
+            member_size = m_ids[member].array_stride * GetOperand(length, 2);
+        }
+        break;
+    }
+    case spv::OpTypeStruct:
+        if (!GetStructSize(member, member_size, depth + 1)) {
+            return false;
+        }
+        break;
+    default:
+        break;
+    }
+    if (!member_size) {
+        return false;
+    }
+    size = info.size_member_offset + member_size;
+    return true;
+}
+
+bool SPIRVModule::AddSpecializationConstant(uint32_t id, SPIRVScanResult& result) const
+{
+    uint32_t type = GetOperand(id, 0);
+    SpecializationConstantDesc desc = {};
+    desc.name = GetString(m_ids[id].name);
+    desc.id = m_ids[id].spec_id;
+    switch (GetOpcode(type)) {
+    case spv::OpTypeBool:
+        desc.type = VariableType::kBool;
+        desc.size = sizeof(uint32_t);
+        desc.default_value = GetOpcode(id) == spv::OpSpecConstantTrue;
+        break;
+    case spv::OpTypeInt:
+        desc.type = GetOperand(type, 2) ? VariableType::kInt : VariableType::kUint;
+        desc.size = GetOperand(type, 1) / 8;
+        desc.default_value = GetOperand(id, 2);
+        break;
+    case spv::OpTypeFloat:
+        desc.type = VariableType::kFloat;
+        desc.size = GetOperand(type, 1) / 8;
+        desc.default_value = GetOperand(id, 2);
+        break;
+    default:
+        return false;
+    }
+    if (desc.size != sizeof(uint16_t) && desc.size != sizeof(uint32_t)) {
+        return false;
+    }
+    result.specialization_constants.emplace_back(std::move(desc));
+    return true;
+}
+
+bool SPIRVModule::AddInputParameter(uint32_t id, uint32_t type, SPIRVScanResult& result) const
+{
+    uint32_t count = 1;
+    GetArrayCount(type, count);
+    uint32_t vecsize = 1;
+    if (GetOpcode(type) == spv::OpTypeVector) {
+        vecsize = GetOperand(type, 2);
+        type = GetOperand(type, 1);
+    }
+
+    decltype(auto) input = result.input_parameters.emplace_back();
+    input.location = m_ids[id].location;
+    input.semantic_name = GetString(m_ids[id].semantic);
+    if (!input.semantic_name.empty() && input.semantic_name.back() == '0') {
+        input.semantic_name.pop_back();
+    }
+    input.format = GetInputFormat(GetOpcode(type), GetOperand(type, 1), GetOperand(type, 2), vecsize);
+    return true;
+}
+
+} // namespace
+
+bool ScanSPIRV(const uint32_t* words, size_t word_count, SPIRVScanResult& result)
+{
+    result = {};
+    SPIRVModule module(words, word_count);
+    if (!module.Scan(result)) {
+        result = {};
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "ShaderReflection/ShaderReflection.h"
+
+#include <cstdint>
+#include <vector>
+
+struct SPIRVScanResult {
+    std::vector<EntryPoint> entry_points;
+    // Listed in the same order as spirv-cross reports them
+    std::vector<ResourceBindingDesc> bindings;
+    // Variable id of each binding, used to look up rich type data with spirv-cross on demand
+    std::vector<uint32_t> binding_ids;
+    std::vector<InputParameterDesc> input_parameters;
+    std::vector<OutputParameterDesc> output_parameters;
+    std::vector<SpecializationConstantDesc> specialization_constants;
+    ShaderFeatureInfo shader_feature_info = {};
+};
+
+// Single pass over the module declarations without per-instruction allocations.
+// Returns false for malformed modules and for constructs the scanner doesn't handle,
+// spirv-cross should be used in that case.
+bool ScanSPIRV(const uint32_t* words, size_t word_count, SPIRVScanResult& result);
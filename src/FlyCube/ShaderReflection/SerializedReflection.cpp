@@ -0,0 +1,359 @@
+#include "ShaderReflection/SerializedReflection.h"
+
+#include "Utilities/Hash.h"
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace {
+
+constexpr uint32_t kMagic = 0x52534346; // FCSR
+constexpr uint32_t kVersion = 6;
+// Bounds the recursion of nested struct members in malformed records
+constexpr uint32_t kMaxVariableDepth = 64;
+
+class RecordWriter {
+public:
+    template <typename T>
+    void Write(const T& value)
+    {
+        if constexpr (std::is_enum_v<T>) {
+            Write(static_cast<uint32_t>(value));
+        } else {
+            static_assert(std::is_arithmetic_v<T>);
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+            m_data.insert(m_data.end(), bytes, bytes + sizeof(value));
+        }
+    }
+
+    void Write(const std::string& value)
+    {
+        Write(static_cast<uint32_t>(value.size()));
+        m_data.insert(m_data.end(), value.begin(), value.end());
+    }
+
+    void Write(const VariableLayout& layout)
+    {
+        Write(layout.name);
+        Write(layout.type);
+        Write(layout.offset);
+        Write(layout.size);
+        Write(layout.rows);
+        Write(layout.columns);
+        Write(layout.elements);
+        Write(static_cast<uint32_t>(layout.members.size()));
+        for (const auto& member : layout.members) {
+            Write(member);
+        }
+    }
+
+    std::vector<uint8_t>& GetData()
+    {
+        return m_data;
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+class RecordReader {
+public:
+    RecordReader(const void* data, size_t size)
+        : m_data(static_cast<const uint8_t*>(data))
+        , m_size(size)
+    {
+    }
+
+    template <typename T>
+    bool Read(T& value)
+    {
+        if constexpr (std::is_enum_v<T>) {
+            uint32_t raw = 0;
+            if (!Read(raw)) {
+                return false;
+            }
+            value = static_cast<T>(raw);
+            return true;
+        } else {
+            static_assert(std::is_arithmetic_v<T>);
+            if (m_size - m_offset < sizeof(value)) {
+                return false;
+            }
+            std::memcpy(&value, m_data + m_offset, sizeof(value));
+            m_offset += sizeof(value);
+            return true;
+        }
+    }
+
+    bool Read(std::string& value)
+    {
+        uint32_t size = 0;
+        if (!Read(size) || m_size - m_offset < size) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(m_data + m_offset), size);
+        m_offset += size;
+        return true;
+    }
+
+    bool Read(VariableLayout& layout, uint32_t depth = 0)
+    {
+        uint32_t member_count = 0;
+        if (depth > kMaxVariableDepth || !Read(layout.name) || !Read(layout.type) || !Read(layout.offset) ||
+            !Read(layout.size) || !Read(layout.rows) || !Read(layout.columns) || !Read(layout.elements) ||
+            !Read(member_count) || !IsCountValid(member_count)) {
+            return false;
+        }
+        layout.members.resize(member_count);
+        for (auto& member : layout.members) {
+            if (!Read(member, depth + 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every element takes at least one byte, so larger counts can only come from a malformed record
+    bool IsCountValid(uint32_t count) const
+    {
+        return count <= m_size - m_offset;
+    }
+
+    bool IsEnd() const
+    {
+        return m_offset == m_size;
+    }
+
+private:
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset = 0;
+};
+
+} // namespace
+
+SerializedReflection::SerializedReflection(const void* data, size_t size)
+{
+    RecordReader reader(data, size);
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t blob_size = 0;
+    if (!reader.Read(magic) || magic != kMagic || !reader.Read(version) || version != kVersion ||
+        !reader.Read(blob_size)) {
+        return;
+    }
+
+    uint32_t count = 0;
+    if (!reader.Read(count) || !reader.IsCountValid(count)) {
+        return;
+    }
+    m_entry_points.resize(count);
+    for (auto& entry_point : m_entry_points) {
+        if (!reader.Read(entry_point.name) || !reader.Read(entry_point.kind) ||
+            !reader.Read(entry_point.payload_size) || !reader.Read(entry_point.attribute_size)) {
+            return;
+        }
+    }
+
+    if (!reader.Read(count) || !reader.IsCountValid(count)) {
+        return;
+    }
+    m_bindings.resize(count);
+    for (auto& binding : m_bindings) {
+        if (!reader.Read(binding.name) || !reader.Read(binding.type) || !reader.Read(binding.slot) ||
+            !reader.Read(binding.space) || !reader.Read(binding.count) || !reader.Read(binding.dimension) ||
+            !reader.Read(binding.return_type) || !reader.Read(binding.structure_stride) ||
+            !reader.Read(binding.is_root_constant)) {
+            return;
+        }
+    }
+
+    if (!reader.Read(count) || !reader.IsCountValid(count)) {
+        return;
+    }
+    m_layouts.resize(count);
+    for (auto& layout : m_layouts) {
+        if (!reader.Read(layout)) {
+            return;
+        }
+    }
+
+    if (!reader.Read(count) || !reader.IsCountValid(count)) {
+        return;
+    }
+    m_input_parameters.resize(count);
+    for (auto& parameter : m_input_parameters) {
+        if (!reader.Read(parameter.location) || !reader.Read(parameter.semantic_name) ||
+            !reader.Read(parameter.format)) {
+            return;
+        }
+    }
+
+    if (!reader.Read(count) || !reader.IsCountValid(count)) {
+        return;
+    }
+    m_output_parameters.resize(count);
+    for (auto& parameter : m_output_parameters) {
+        if (!reader.Read(parameter.slot)) {
+            return;
+        }
+    }
+
+    if (!reader.Read(count) || !reader.IsCountValid(count)) {
+        return;
+    }
+    m_specialization_constants.resize(count);
+    for (auto& constant : m_specialization_constants) {
+        if (!reader.Read(constant.name) || !reader.Read(constant.id) || !reader.Read(constant.type) ||
+            !reader.Read(constant.size) || !reader.Read(constant.default_value)) {
+            return;
+        }
+    }
+
+    uint8_t resource_descriptor_heap_indexing = 0;
+    uint8_t sampler_descriptor_heap_indexing = 0;
+    if (!reader.Read(resource_descriptor_heap_indexing) || !reader.Read(sampler_descriptor_heap_indexing)) {
+        return;
+    }
+    m_shader_feature_info.resource_descriptor_heap_indexing = resource_descriptor_heap_indexing;
+    m_shader_feature_info.sampler_descriptor_heap_indexing = sampler_descriptor_heap_indexing;
+    for (auto& numthreads : m_shader_feature_info.numthreads) {
+        if (!reader.Read(numthreads)) {
+            return;
+        }
+    }
+
+    m_is_valid = reader.IsEnd();
+}
+
+bool SerializedReflection::IsValid() const
+{
+    return m_is_valid;
+}
+
+const std::vector<EntryPoint>& SerializedReflection::GetEntryPoints() const
+{
+    return m_entry_points;
+}
+
+const std::vector<ResourceBindingDesc>& SerializedReflection::GetBindings() const
+{
+    return m_bindings;
+}
+
+const std::vector<VariableLayout>& SerializedReflection::GetVariableLayouts() const
+{
+    return m_layouts;
+}
+
+const std::vector<InputParameterDesc>& SerializedReflection::GetInputParameters() const
+{
+    return m_input_parameters;
+}
+
+const std::vector<OutputParameterDesc>& SerializedReflection::GetOutputParameters() const
+{
+    return m_output_parameters;
+}
+
+const std::vector<SpecializationConstantDesc>& SerializedReflection::GetSpecializationConstants() const
+{
+    return m_specialization_constants;
+}
+
+const ShaderFeatureInfo& SerializedReflection::GetShaderFeatureInfo() const
+{
+    return m_shader_feature_info;
+}
+
+std::vector<uint8_t> SerializeShaderReflection(const ShaderReflection& reflection, const void* blob, size_t blob_size)
+{
+    RecordWriter writer;
+    writer.Write(kMagic);
+    writer.Write(kVersion);
+    writer.Write(HashBytes(blob, blob_size));
+
+    decltype(auto) entry_points = reflection.GetEntryPoints();
+    writer.Write(static_cast<uint32_t>(entry_points.size()));
+    for (const auto& entry_point : entry_points) {
+        writer.Write(entry_point.name);
+        writer.Write(entry_point.kind);
+        writer.Write(entry_point.payload_size);
+        writer.Write(entry_point.attribute_size);
+    }
+
+    decltype(auto) bindings = reflection.GetBindings();
+    writer.Write(static_cast<uint32_t>(bindings.size()));
+    for (const auto& binding : bindings) {
+        writer.Write(binding.name);
+        writer.Write(binding.type);
+        writer.Write(binding.slot);
+        writer.Write(binding.space);
+        writer.Write(binding.count);
+        writer.Write(binding.dimension);
+        writer.Write(binding.return_type);
+        writer.Write(binding.structure_stride);
+        writer.Write(binding.is_root_constant);
+    }
+
+    decltype(auto) layouts = reflection.GetVariableLayouts();
+    writer.Write(static_cast<uint32_t>(layouts.size()));
+    for (const auto& layout : layouts) {
+        writer.Write(layout);
+    }
+
+    decltype(auto) input_parameters = reflection.GetInputParameters();
+    writer.Write(static_cast<uint32_t>(input_parameters.size()));
+    for (const auto& parameter : input_parameters) {
+        writer.Write(parameter.location);
+        writer.Write(parameter.semantic_name);
+        writer.Write(parameter.format);
+    }
+
+    decltype(auto) output_parameters = reflection.GetOutputParameters();
+    writer.Write(static_cast<uint32_t>(output_parameters.size()));
+    for (const auto& parameter : output_parameters) {
+        writer.Write(parameter.slot);
+    }
+
+    decltype(auto) specialization_constants = reflection.GetSpecializationConstants();
+    writer.Write(static_cast<uint32_t>(specialization_constants.size()));
+    for (const auto& constant : specialization_constants) {
+        writer.Write(constant.name);
+        writer.Write(constant.id);
+        writer.Write(constant.type);
+        writer.Write(constant.size);
+        writer.Write(constant.default_value);
+    }
+
+    decltype(auto) feature_info = reflection.GetShaderFeatureInfo();
+    writer.Write(static_cast<uint8_t>(feature_info.resource_descriptor_heap_indexing));
+    writer.Write(static_cast<uint8_t>(feature_info.sampler_descriptor_heap_indexing));
+    for (uint32_t numthreads : feature_info.numthreads) {
+        writer.Write(numthreads);
+    }
+    return std::move(writer.GetData());
+}
+
+std::shared_ptr<ShaderReflection> CreateSerializedReflection(const void* data,
+                                                             size_t size,
+                                                             const void* blob,
+                                                             size_t blob_size)
+{
+    uint64_t record_blob_hash = 0;
+    constexpr size_t kBlobHashOffset = sizeof(kMagic) + sizeof(kVersion);
+    if (size < kBlobHashOffset + sizeof(record_blob_hash)) {
+        return nullptr;
+    }
+    std::memcpy(&record_blob_hash, static_cast<const uint8_t*>(data) + kBlobHashOffset, sizeof(record_blob_hash));
+    if (record_blob_hash != HashBytes(blob, blob_size)) {
+        return nullptr;
+    }
+
+    auto reflection = std::make_shared<SerializedReflection>(data, size);
+    if (!reflection->IsValid()) {
+        return nullptr;
+    }
+    return reflection;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include "ShaderReflection/ShaderReflection.h"
+
+#include <cstdint>
+#include <vector>
+
+// Appended to the blob file name for the reflection record stored next to it
+constexpr const char* kShaderReflectionExtension = ".refl";
+
+// Reflection restored from a record written by SerializeShaderReflection, much cheaper than parsing the module
+class SerializedReflection : public ShaderReflection {
+public:
+    SerializedReflection(const void* data, size_t size);
+    bool IsValid() const;
+    const std::vector<EntryPoint>& GetEntryPoints() const override;
+    const std::vector<ResourceBindingDesc>& GetBindings() const override;
+    const std::vector<VariableLayout>& GetVariableLayouts() const override;
+    const std::vector<InputParameterDesc>& GetInputParameters() const override;
+    const std::vector<OutputParameterDesc>& GetOutputParameters() const override;
+    const std::vector<SpecializationConstantDesc>& GetSpecializationConstants() const override;
+    const ShaderFeatureInfo& GetShaderFeatureInfo() const override;
+
+private:
+    bool m_is_valid = false;
+    std::vector<EntryPoint> m_entry_points;
+    std::vector<ResourceBindingDesc> m_bindings;
+    std::vector<VariableLayout> m_layouts;
+    std::vector<InputParameterDesc> m_input_parameters;
+    std::vector<OutputParameterDesc> m_output_parameters;
+    std::vector<SpecializationConstantDesc> m_specialization_constants;
+    ShaderFeatureInfo m_shader_feature_info = {};
+};
+
+// A hash of the blob is stored in the record so that a record left next to a rebuilt blob is rejected
+std::vector<uint8_t> SerializeShaderReflection(const ShaderReflection& reflection, const void* blob, size_t blob_size);
+// Returns nullptr if the record is malformed or was written for another blob
+std::shared_ptr<ShaderReflection> CreateSerializedReflection(const void* data,
+                                                             size_t size,
+                                                             const void* blob,
+                                                             size_t blob_size);
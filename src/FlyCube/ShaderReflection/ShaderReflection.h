@@ -43,7 +43,7 @@ inline bool operator<(const EntryPoint& lhs, const EntryPoint& rhs)
 
 inline auto MakeTie(const ResourceBindingDesc& desc)
 {
-    return std::tie(desc.name, desc.type, desc.slot, desc.space, desc.dimension);
+    return std::tie(desc.name, desc.type, desc.slot, desc.space, desc.dimension, desc.is_root_constant);
 };
 
 inline bool operator==(const ResourceBindingDesc& lhs, const ResourceBindingDesc& rhs)
@@ -100,6 +100,26 @@ inline bool operator<(const VariableLayout& lhs, const VariableLayout& rhs)
     return MakeTie(lhs) < MakeTie(rhs);
 }
 
+// Declared with [[vk::constant_id(N)]], only SPIR-V modules report them
+struct SpecializationConstantDesc {
+    std::string name;
+    uint32_t id;
+    VariableType type;
+    // Bytes of the value, 2 for 16-bit types, booleans take 4 like VkBool32
+    uint32_t size;
+    uint32_t default_value;
+};
+
+inline auto MakeTie(const SpecializationConstantDesc& desc)
+{
+    return std::tie(desc.name, desc.id, desc.type, desc.size, desc.default_value);
+};
+
+inline bool operator==(const SpecializationConstantDesc& lhs, const SpecializationConstantDesc& rhs)
+{
+    return MakeTie(lhs) == MakeTie(rhs);
+}
+
 struct ShaderFeatureInfo {
     bool resource_descriptor_heap_indexing = false;
     bool sampler_descriptor_heap_indexing = false;
@@ -114,6 +134,8 @@ public:
     virtual const std::vector<VariableLayout>& GetVariableLayouts() const = 0;
     virtual const std::vector<InputParameterDesc>& GetInputParameters() const = 0;
     virtual const std::vector<OutputParameterDesc>& GetOutputParameters() const = 0;
+    // Sorted by id
+    virtual const std::vector<SpecializationConstantDesc>& GetSpecializationConstants() const = 0;
     virtual const ShaderFeatureInfo& GetShaderFeatureInfo() const = 0;
 };
 
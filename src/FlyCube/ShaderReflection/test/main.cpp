@@ -1,8 +1,17 @@
 #include "HLSLCompiler/Compiler.h"
+#include "ShaderReflection/ConstantBufferWriter.h"
+#include "ShaderReflection/SPIRVReflection.h"
+#include "ShaderReflection/SPIRVScanner.h"
+#include "ShaderReflection/SerializedReflection.h"
 #include "ShaderReflection/ShaderReflection.h"
 
 #include <catch2/catch_all.hpp>
 
+#include <array>
+#include <cstring>
+#include <map>
+#include <tuple>
+
 class ShaderTestCase {
 public:
     virtual const ShaderDesc& GetShaderDesc() const = 0;
@@ -120,3 +129,335 @@ TEST_CASE("TriangleVS")
 {
     RunTest(TriangleVS{});
 }
+
+class Serialized : public ShaderTestCase {
+public:
+    const ShaderDesc& GetShaderDesc() const override
+    {
+        return m_desc;
+    }
+
+    void Test(ShaderBlobType type, const void* data, size_t size) const override
+    {
+        auto reflection = CreateShaderReflection(type, data, size);
+        REQUIRE(reflection);
+        auto record = SerializeShaderReflection(*reflection, data, size);
+        std::vector<uint8_t> rebuilt_blob(static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        rebuilt_blob.back() ^= 1;
+        REQUIRE(!CreateSerializedReflection(record.data(), record.size(), rebuilt_blob.data(), rebuilt_blob.size()));
+        REQUIRE(!CreateSerializedReflection(record.data(), record.size() - 1, data, size));
+
+        auto serialized = CreateSerializedReflection(record.data(), record.size(), data, size);
+        REQUIRE(serialized);
+        REQUIRE(serialized->GetEntryPoints() == reflection->GetEntryPoints());
+        REQUIRE(serialized->GetBindings() == reflection->GetBindings());
+        REQUIRE(serialized->GetVariableLayouts() == reflection->GetVariableLayouts());
+        REQUIRE(serialized->GetInputParameters().size() == reflection->GetInputParameters().size());
+        REQUIRE(serialized->GetOutputParameters().size() == reflection->GetOutputParameters().size());
+        REQUIRE(serialized->GetSpecializationConstants() == reflection->GetSpecializationConstants());
+        REQUIRE(serialized->GetShaderFeatureInfo().numthreads == reflection->GetShaderFeatureInfo().numthreads);
+    }
+
+private:
+    ShaderDesc m_desc = { ASSETS_PATH "shaders/Triangle/PixelShader.hlsl", "main", ShaderType::kPixel, "6_3" };
+};
+
+TEST_CASE("Serialized")
+{
+    RunTest(Serialized{});
+}
+
+class RootConstants : public ShaderTestCase {
+public:
+    RootConstants()
+    {
+        m_desc.source = "struct Constants { float4 color; uint index; };\n"
+                        "[[vk::push_constant]] ConstantBuffer<Constants> constants : register(b0, space1000);\n"
+                        "float4 main() : SV_TARGET { return constants.color * constants.index; }";
+    }
+
+    const ShaderDesc& GetShaderDesc() const override
+    {
+        return m_desc;
+    }
+
+    void Test(ShaderBlobType type, const void* data, size_t size) const override
+    {
+        auto reflection = CreateShaderReflection(type, data, size);
+        REQUIRE(reflection);
+        const auto& bindings = reflection->GetBindings();
+        REQUIRE(bindings.size() == 1);
+        REQUIRE(bindings[0].type == ViewType::kConstantBuffer);
+        REQUIRE(bindings[0].is_root_constant);
+        REQUIRE(bindings[0].count == 5);
+
+        auto record = SerializeShaderReflection(*reflection, data, size);
+        auto serialized = CreateSerializedReflection(record.data(), record.size(), data, size);
+        REQUIRE(serialized);
+        REQUIRE(serialized->GetBindings()[0].is_root_constant);
+    }
+
+private:
+    ShaderDesc m_desc = { "memory/RootConstants.hlsl", "main", ShaderType::kPixel, "6_3" };
+};
+
+TEST_CASE("RootConstants")
+{
+    RunTest(RootConstants{});
+
+    auto blob = Compile(RootConstants{}.GetShaderDesc(), ShaderBlobType::kSPIRV);
+    REQUIRE(!blob.empty());
+    SPIRVReflection scanner(blob.data(), blob.size());
+    SPIRVReflection spirv_cross(blob.data(), blob.size(), /*use_scanner=*/false);
+    REQUIRE(scanner.GetBindings() == spirv_cross.GetBindings());
+    REQUIRE(scanner.GetBindings()[0].count == spirv_cross.GetBindings()[0].count);
+}
+
+class SpecializationConstants : public ShaderTestCase {
+public:
+    SpecializationConstants()
+    {
+        m_desc.source = "[[vk::constant_id(1)]] const uint kTileSize = 8;\n"
+                        "[[vk::constant_id(0)]] const bool kEnable = true;\n"
+                        "[[vk::constant_id(2)]] const float kScale = 1.5;\n"
+                        "RWStructuredBuffer<float> result : register(u0);\n"
+                        "[numthreads(8, 1, 1)] void main(uint3 id : SV_DispatchThreadID)\n"
+                        "{ result[id.x] = kEnable ? kScale * kTileSize : 0; }";
+    }
+
+    const ShaderDesc& GetShaderDesc() const override
+    {
+        return m_desc;
+    }
+
+    void Test(ShaderBlobType type, const void* data, size_t size) const override
+    {
+        auto reflection = CreateShaderReflection(type, data, size);
+        REQUIRE(reflection);
+        const auto& constants = reflection->GetSpecializationConstants();
+        if (type == ShaderBlobType::kDXIL) {
+            REQUIRE(constants.empty());
+            return;
+        }
+
+        std::vector<std::tuple<uint32_t, VariableType, uint32_t, uint32_t>> expect = {
+            { 0, VariableType::kBool, 4, 1 },
+            { 1, VariableType::kUint, 4, 8 },
+            { 2, VariableType::kFloat, 4, 0x3fc00000 },
+        };
+        REQUIRE(constants.size() == expect.size());
+        for (size_t i = 0; i < constants.size(); ++i) {
+            REQUIRE(std::tie(constants[i].id, constants[i].type, constants[i].size, constants[i].default_value) ==
+                    expect[i]);
+        }
+
+        SPIRVReflection spirv_cross(data, size, /*use_scanner=*/false);
+        REQUIRE(constants == spirv_cross.GetSpecializationConstants());
+    }
+
+private:
+    ShaderDesc m_desc = { "memory/SpecializationConstants.hlsl", "main", ShaderType::kCompute, "6_3" };
+};
+
+TEST_CASE("SpecializationConstants")
+{
+    RunTest(SpecializationConstants{});
+}
+
+class NativeTypes16Bit : public ShaderTestCase {
+public:
+    NativeTypes16Bit()
+    {
+        m_desc.source = "float4 main(half3 pos : POSITION, uint16_t2 id : INSTANCE, int16_t4 offset : OFFSET)"
+                        " : SV_POSITION\n"
+                        "{ return float4(pos + offset.xyz, id.x + id.y); }";
+        m_desc.options.enable_16bit_types = true;
+    }
+
+    const ShaderDesc& GetShaderDesc() const override
+    {
+        return m_desc;
+    }
+
+    void Test(ShaderBlobType type, const void* data, size_t size) const override
+    {
+        auto reflection = CreateShaderReflection(type, data, size);
+        REQUIRE(reflection);
+
+        std::map<std::string, gli::format> expect = {
+            { "POSITION", gli::format::FORMAT_RGB16_SFLOAT_PACK16 },
+            { "INSTANCE", gli::format::FORMAT_RG16_UINT_PACK16 },
+            { "OFFSET", gli::format::FORMAT_RGBA16_SINT_PACK16 },
+        };
+        std::map<std::string, gli::format> formats;
+        for (const auto& input : reflection->GetInputParameters()) {
+            formats[input.semantic_name] = input.format;
+        }
+        REQUIRE(formats == expect);
+
+        if (type == ShaderBlobType::kSPIRV) {
+            SPIRVReflection spirv_cross(data, size, /*use_scanner=*/false);
+            REQUIRE(reflection->GetInputParameters().size() == spirv_cross.GetInputParameters().size());
+            for (size_t i = 0; i < spirv_cross.GetInputParameters().size(); ++i) {
+                REQUIRE(reflection->GetInputParameters()[i].format == spirv_cross.GetInputParameters()[i].format);
+            }
+        }
+    }
+
+private:
+    ShaderDesc m_desc = { "memory/NativeTypes16Bit.hlsl", "main", ShaderType::kVertex, "6_2" };
+};
+
+TEST_CASE("NativeTypes16Bit")
+{
+    RunTest(NativeTypes16Bit{});
+}
+
+class ConstantBuffer : public ShaderTestCase {
+public:
+    ConstantBuffer()
+    {
+        m_desc.source = "cbuffer Settings : register(b0)\n"
+                        "{ float scale; float3 color; uint flags; float2 weights[3]; };\n"
+                        "float4 main() : SV_TARGET { return float4(color * scale, weights[flags % 3].x); }";
+    }
+
+    const ShaderDesc& GetShaderDesc() const override
+    {
+        return m_desc;
+    }
+
+    void Test(ShaderBlobType type, const void* data, size_t size) const override
+    {
+        auto reflection = CreateShaderReflection(type, data, size);
+        REQUIRE(reflection);
+        const VariableLayout* layout = FindConstantBufferLayout(*reflection, "Settings");
+        REQUIRE(layout);
+        REQUIRE(!FindConstantBufferLayout(*reflection, "Unknown"));
+
+        std::vector<uint8_t> mapped_data(layout->size);
+        ConstantBufferWriter writer(*layout, mapped_data.data());
+        REQUIRE(writer.GetSize() == 80);
+        REQUIRE(writer.GetDirtyRange().size == writer.GetSize());
+        writer.ResetDirtyRange();
+
+        auto scale = writer.GetHandle("scale");
+        auto color = writer.GetHandle("color");
+        auto weight = writer.GetHandle("weights[2]");
+        auto flags = writer.GetHandle("flags");
+        REQUIRE(scale.offset == 0);
+        REQUIRE(color.offset == 4);
+        REQUIRE(flags.offset == 16);
+        REQUIRE(weight.offset == 64);
+        REQUIRE(weight.size == 16);
+        REQUIRE(!writer.GetHandle("weights[3]").IsValid());
+        REQUIRE(!writer.GetHandle("weights.x").IsValid());
+        REQUIRE(!writer.GetHandle("scale[0]").IsValid());
+        REQUIRE(!writer.GetHandle("unknown").IsValid());
+
+        writer.Write(scale, 0.0f);
+        REQUIRE(writer.GetDirtyRange().size == 0);
+        writer.Write(weight, std::array<float, 2>{ 1.0f, 2.0f });
+        REQUIRE(writer.GetDirtyRange().offset == 64);
+        REQUIRE(writer.GetDirtyRange().size == 8);
+        writer.Write(color, std::array<float, 3>{ 1.0f, 0.5f, 0.25f });
+        REQUIRE(writer.GetDirtyRange().offset == 4);
+        REQUIRE(writer.GetDirtyRange().size == 68);
+        REQUIRE(mapped_data == writer.GetData());
+    }
+
+private:
+    ShaderDesc m_desc = { "memory/ConstantBuffer.hlsl", "main", ShaderType::kPixel, "6_3" };
+};
+
+TEST_CASE("ConstantBuffer")
+{
+    RunTest(ConstantBuffer{});
+}
+
+std::vector<ShaderDesc> GetSPIRVScannerShaders()
+{
+    return {
+        { ASSETS_PATH "shaders/DxrTriangle/RayTracing.hlsl", "", ShaderType::kLibrary, "6_3" },
+        { ASSETS_PATH "shaders/MeshTriangle/MeshShader.hlsl", "main", ShaderType::kMesh, "6_5" },
+        { ASSETS_PATH "shaders/MeshTriangle/PixelShader.hlsl", "main", ShaderType::kPixel, "6_5" },
+        { ASSETS_PATH "shaders/Triangle/PixelShader.hlsl", "main", ShaderType::kPixel, "6_3" },
+        { ASSETS_PATH "shaders/Triangle/PixelShaderNoBindings.hlsl", "main", ShaderType::kPixel, "6_3" },
+        { ASSETS_PATH "shaders/Triangle/VertexShader.hlsl", "main", ShaderType::kVertex, "6_3" },
+    };
+}
+
+TEST_CASE("SPIRVScanner")
+{
+    for (const auto& desc : GetSPIRVScannerShaders()) {
+        auto blob = Compile(desc, ShaderBlobType::kSPIRV);
+        REQUIRE(!blob.empty());
+        SPIRVScanResult scan_result;
+        REQUIRE(ScanSPIRV(reinterpret_cast<const uint32_t*>(blob.data()), blob.size() / sizeof(uint32_t), scan_result));
+
+        SPIRVReflection scanner(blob.data(), blob.size());
+        SPIRVReflection spirv_cross(blob.data(), blob.size(), /*use_scanner=*/false);
+
+        auto entry_points = scanner.GetEntryPoints();
+        auto expect_entry_points = spirv_cross.GetEntryPoints();
+        sort(entry_points.begin(), entry_points.end());
+        sort(expect_entry_points.begin(), expect_entry_points.end());
+        REQUIRE(entry_points == expect_entry_points);
+
+        const auto& bindings = scanner.GetBindings();
+        const auto& expect_bindings = spirv_cross.GetBindings();
+        REQUIRE(bindings == expect_bindings);
+        for (size_t i = 0; i < bindings.size(); ++i) {
+            REQUIRE(bindings[i].count == expect_bindings[i].count);
+            REQUIRE(bindings[i].return_type == expect_bindings[i].return_type);
+            REQUIRE(bindings[i].structure_stride == expect_bindings[i].structure_stride);
+        }
+        REQUIRE(scanner.GetVariableLayouts() == spirv_cross.GetVariableLayouts());
+
+        const auto& inputs = scanner.GetInputParameters();
+        const auto& expect_inputs = spirv_cross.GetInputParameters();
+        REQUIRE(inputs.size() == expect_inputs.size());
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            REQUIRE(inputs[i].location == expect_inputs[i].location);
+            REQUIRE(inputs[i].semantic_name == expect_inputs[i].semantic_name);
+            REQUIRE(inputs[i].format == expect_inputs[i].format);
+        }
+
+        const auto& outputs = scanner.GetOutputParameters();
+        const auto& expect_outputs = spirv_cross.GetOutputParameters();
+        REQUIRE(outputs.size() == expect_outputs.size());
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            REQUIRE(outputs[i].slot == expect_outputs[i].slot);
+        }
+        REQUIRE(scanner.GetShaderFeatureInfo().numthreads == spirv_cross.GetShaderFeatureInfo().numthreads);
+    }
+
+    std::vector<uint32_t> truncated = { 0x07230203, 0x10000, 0, 16, 0, 0x00040000 | 15 };
+    SPIRVScanResult scan_result;
+    REQUIRE(!ScanSPIRV(truncated.data(), truncated.size(), scan_result));
+}
+
+// Hidden by default, run with: ShaderReflectionTest "[benchmark]"
+TEST_CASE("SPIRVScannerBenchmark", "[.][benchmark]")
+{
+    for (const auto& desc : GetSPIRVScannerShaders()) {
+        auto blob = Compile(desc, ShaderBlobType::kSPIRV);
+        REQUIRE(!blob.empty());
+        std::string name = desc.shader_path.substr(strlen(ASSETS_PATH));
+
+        BENCHMARK("ScanSPIRV " + name)
+        {
+            SPIRVScanResult scan_result;
+            ScanSPIRV(reinterpret_cast<const uint32_t*>(blob.data()), blob.size() / sizeof(uint32_t), scan_result);
+            return scan_result.bindings.size();
+        };
+        BENCHMARK("SPIRVReflection " + name)
+        {
+            return SPIRVReflection(blob.data(), blob.size()).GetBindings().size();
+        };
+        BENCHMARK("spirv-cross " + name)
+        {
+            return SPIRVReflection(blob.data(), blob.size(), /*use_scanner=*/false).GetBindings().size();
+        };
+    }
+}
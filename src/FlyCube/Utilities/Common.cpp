@@ -1,10 +1,13 @@
 #include "Utilities/Common.h"
 
+#include "HLSLCompiler/MSLConverter.h"
+#include "ShaderReflection/SerializedReflection.h"
+#include "Utilities/MappedFile.h"
 #include "Utilities/SystemUtils.h"
 
 #include <filesystem>
-#include <fstream>
-#include <iterator>
+#include <map>
+#include <mutex>
 
 #if defined(__APPLE__)
 #import <Foundation/Foundation.h>
@@ -18,28 +21,25 @@ namespace {
 AAssetManager* g_asset_manager = nullptr;
 #endif
 
-std::vector<uint8_t> LoadBinaryFile(const std::string& filepath)
+ShaderBlob MapBinaryFile(const std::string& filepath)
 {
 #if defined(__ANDROID__)
     AAsset* file = AAssetManager_open(g_asset_manager, filepath.c_str(), AASSET_MODE_BUFFER);
-    auto filesize = AAsset_getLength64(file);
-    std::vector<uint8_t> data(filesize);
-    AAsset_read(file, data.data(), filesize);
-    AAsset_close(file);
-    return data;
+    if (!file) {
+        return {};
+    }
+    std::shared_ptr<AAsset> asset(file, AAsset_close);
+    const uint8_t* data = static_cast<const uint8_t*>(AAsset_getBuffer(file));
+    if (!data) {
+        return {};
+    }
+    return ShaderBlob(data, AAsset_getLength64(file), asset);
 #else
-    std::ifstream file(filepath, std::ios::binary);
-    file.unsetf(std::ios::skipws);
-
-    std::streampos filesize;
-    file.seekg(0, std::ios::end);
-    filesize = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    std::vector<uint8_t> data;
-    data.reserve(filesize);
-    data.insert(data.begin(), std::istream_iterator<uint8_t>(file), std::istream_iterator<uint8_t>());
-    return data;
+    auto file = std::make_shared<MappedFile>(filepath);
+    if (!file->IsValid()) {
+        return {};
+    }
+    return ShaderBlob(file->GetData(), file->GetSize(), file);
 #endif
 }
 
@@ -77,9 +77,53 @@ std::string GetAssertPath(const std::string& filepath)
     return GetExecutableDir() + "\\" + filepath;
 }
 
-std::vector<uint8_t> LoadShaderBlob(const std::string& filepath, ShaderBlobType blob_type)
+ShaderBlob LoadShaderBlob(const std::string& filepath, ShaderBlobType blob_type)
+{
+    auto path = std::filesystem::u8path(filepath);
+    for (auto dir = path.parent_path(); !dir.empty(); dir = dir.parent_path()) {
+        auto archive = LoadShaderArchive((dir / kShaderArchiveFileName).u8string());
+        if (archive) {
+            ShaderBlob blob = archive->GetBlob(path.lexically_relative(dir).generic_u8string(), blob_type);
+            if (!blob.empty()) {
+                return blob;
+            }
+        }
+        if (dir == dir.parent_path()) {
+            break;
+        }
+    }
+    std::string blob_path = GetShaderBlob(filepath, blob_type);
+    ShaderBlob blob = MapBinaryFile(blob_path);
+    if (!blob.empty()) {
+        blob.SetReflectionRecord(MapBinaryFile(blob_path + kShaderReflectionExtension));
+        if (blob_type == ShaderBlobType::kSPIRV) {
+            blob.SetMSLRecord(MapBinaryFile(GetAssertPath(filepath + kMSLExtension)));
+        }
+    }
+    return blob;
+}
+
+std::shared_ptr<ShaderArchive> LoadShaderArchive(const std::string& filepath)
 {
-    return LoadBinaryFile(GetShaderBlob(filepath, blob_type));
+    // Only loaded archives are cached, an archive built after a failed probe is still found by the next load
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<ShaderArchive>> archives;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = archives.find(filepath);
+    if (it != archives.end()) {
+        return it->second;
+    }
+
+    ShaderBlob data = MapBinaryFile(GetAssertPath(filepath));
+    if (data.empty()) {
+        return nullptr;
+    }
+    auto archive = std::make_shared<ShaderArchive>(data);
+    if (!archive->IsValid()) {
+        return nullptr;
+    }
+    archives.emplace(filepath, archive);
+    return archive;
 }
 
 #if defined(__ANDROID__)
@@ -1,14 +1,21 @@
 #pragma once
 
 #include "Instance/BaseTypes.h"
+#include "Shader/ShaderArchive.h"
+#include "Shader/ShaderBlob.h"
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 uint64_t Align(uint64_t size, uint64_t alignment);
 std::string GetAssertPath(const std::string& filepath);
-std::vector<uint8_t> LoadShaderBlob(const std::string& filepath, ShaderBlobType blob_type);
+// Blobs are looked up in the shader archives of the parent directories first and then as separate files,
+// with the reflection and MSL records from the archive entry or the sidecar files next to the blob.
+// Both are memory-mapped, so the returned blob references the file contents without a copy.
+ShaderBlob LoadShaderBlob(const std::string& filepath, ShaderBlobType blob_type);
+std::shared_ptr<ShaderArchive> LoadShaderArchive(const std::string& filepath);
 
 #if defined(__ANDROID__)
 struct AAssetManager;
@@ -0,0 +1,88 @@
+#include "Utilities/FileWatcher.h"
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <filesystem>
+
+namespace {
+
+std::string NormalizePath(const std::string& path)
+{
+    return std::filesystem::u8path(path).lexically_normal().u8string();
+}
+
+} // namespace
+
+FileWatcher::FileWatcher()
+{
+#if defined(__linux__)
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#if defined(__linux__)
+    if (m_fd != -1) {
+        close(m_fd);
+    }
+#endif
+}
+
+void FileWatcher::AddFile(const std::string& path)
+{
+    std::string file = NormalizePath(path);
+    if (!m_files.insert(file).second) {
+        return;
+    }
+
+#if defined(__linux__)
+    // Editors often save by replacing the file, so the containing directory is watched instead of the file
+    std::string dir = std::filesystem::u8path(file).parent_path().u8string();
+    if (dir.empty()) {
+        dir = ".";
+    }
+    if (m_fd == -1 || m_dirs.count(dir)) {
+        return;
+    }
+    int wd = inotify_add_watch(m_fd, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    if (wd != -1) {
+        m_dirs.insert(dir);
+        m_watch_dirs[wd] = dir;
+    }
+#endif
+}
+
+std::set<std::string> FileWatcher::PollChanges()
+{
+    std::set<std::string> changes;
+#if defined(__linux__)
+    if (m_fd == -1) {
+        return changes;
+    }
+
+    alignas(inotify_event) char buffer[4096];
+    while (true) {
+        ssize_t size = read(m_fd, buffer, sizeof(buffer));
+        if (size <= 0) {
+            break;
+        }
+        for (char* ptr = buffer; ptr < buffer + size;) {
+            const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+            auto it = m_watch_dirs.find(event->wd);
+            if (it == m_watch_dirs.end() || event->len == 0) {
+                continue;
+            }
+            std::string file = NormalizePath(it->second + "/" + event->name);
+            if (m_files.count(file)) {
+                changes.insert(file);
+            }
+        }
+    }
+#endif
+    return changes;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+
+// Reports modifications of individual files, implemented with inotify on Linux and a no-op elsewhere
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    void AddFile(const std::string& path);
+    // Watched files written, created or replaced since the previous call, never blocks
+    std::set<std::string> PollChanges();
+
+private:
+    std::set<std::string> m_files;
+#if defined(__linux__)
+    int m_fd = -1;
+    std::map<int, std::string> m_watch_dirs;
+    std::set<std::string> m_dirs;
+#endif
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class Hasher {
+public:
+    Hasher& Update(const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            m_hash ^= bytes[i];
+            m_hash *= kPrime;
+        }
+        return *this;
+    }
+
+    Hasher& Update(const std::string& str)
+    {
+        uint64_t size = str.size();
+        Update(&size, sizeof(size));
+        return Update(str.data(), str.size());
+    }
+
+    template <typename T>
+    Hasher& Update(const std::vector<T>& data)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        uint64_t size = data.size();
+        Update(&size, sizeof(size));
+        return Update(data.data(), data.size() * sizeof(T));
+    }
+
+    template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>>
+    Hasher& Update(const T& value)
+    {
+        return Update(&value, sizeof(value));
+    }
+
+    uint64_t GetHash() const
+    {
+        return m_hash;
+    }
+
+private:
+    static constexpr uint64_t kOffsetBasis = 0xcbf29ce484222325ull;
+    static constexpr uint64_t kPrime = 0x100000001b3ull;
+
+    uint64_t m_hash = kOffsetBasis;
+};
+
+inline uint64_t HashBytes(const void* data, size_t size)
+{
+    return Hasher().Update(data, size).GetHash();
+}
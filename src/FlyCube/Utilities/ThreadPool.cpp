@@ -0,0 +1,103 @@
+#include "Utilities/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace {
+
+struct ParallelForState {
+    std::function<void(size_t)> fn;
+    size_t count = 0;
+    std::atomic<size_t> next = 0;
+    std::atomic<size_t> done = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    void Run()
+    {
+        for (size_t i = next++; i < count; i = next++) {
+            fn(i);
+            if (++done == count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                cv.notify_all();
+            }
+        }
+    }
+};
+
+} // namespace
+
+ThreadPool::ThreadPool(uint32_t thread_count)
+{
+    for (uint32_t i = 0; i < thread_count; ++i) {
+        m_threads.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& fn)
+{
+    if (count == 0) {
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->fn = fn;
+    state->count = count;
+    size_t helper_count = std::min<size_t>(count - 1, m_threads.size());
+    for (size_t i = 0; i < helper_count; ++i) {
+        Enqueue([state] { state->Run(); });
+    }
+    state->Run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->done == count; });
+}
+
+uint32_t ThreadPool::GetThreadCount() const
+{
+    return m_threads.size();
+}
+
+void ThreadPool::Enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.emplace_back(std::move(task));
+    }
+    m_cv.notify_one();
+}
+
+void ThreadPool::WorkerLoop()
+{
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [&] { return m_stop || !m_tasks.empty(); });
+            if (m_tasks.empty()) {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+ThreadPool& GetThreadPool()
+{
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+    return pool;
+}
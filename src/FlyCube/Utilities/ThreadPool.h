@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool {
+public:
+    explicit ThreadPool(uint32_t thread_count);
+    ~ThreadPool();
+
+    template <typename Fn>
+    std::future<std::invoke_result_t<Fn>> Submit(Fn&& fn)
+    {
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<Fn>()>>(std::forward<Fn>(fn));
+        auto future = task->get_future();
+        Enqueue([task] { (*task)(); });
+        return future;
+    }
+
+    // The calling thread takes part in the work, so it is safe to call from a pool thread
+    void ParallelFor(size_t count, const std::function<void(size_t)>& fn);
+
+    uint32_t GetThreadCount() const;
+
+private:
+    void Enqueue(std::function<void()> task);
+    void WorkerLoop();
+
+    std::vector<std::thread> m_threads;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop = false;
+};
+
+// Sized to std::thread::hardware_concurrency()
+ThreadPool& GetThreadPool();
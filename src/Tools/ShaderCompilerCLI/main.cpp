@@ -1,8 +1,23 @@
 #include "HLSLCompiler/Compiler.h"
+#include "HLSLCompiler/DXCLoader.h"
+#include "HLSLCompiler/MSLConverter.h"
 #include "Instance/BaseTypes.h"
+#include "Shader/ShaderArchive.h"
+#include "ShaderReflection/SerializedReflection.h"
+#include "Utilities/Hash.h"
+#include "Utilities/ThreadPool.h"
 
+#include <algorithm>
 #include <cassert>
+#include <filesystem>
 #include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
 
 namespace {
 
@@ -40,6 +55,20 @@ std::string GetShaderExtension(ShaderBlobType shader_type)
     }
 }
 
+void WriteBlob(const std::string& path, const std::vector<uint8_t>& blob)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::u8path(path).parent_path(), ec);
+    std::fstream file(std::filesystem::u8path(path), std::ios::out | std::ios::binary);
+    file.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+}
+
+std::vector<uint8_t> ReadBlob(const std::string& path)
+{
+    std::ifstream file(std::filesystem::u8path(path), std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
 void CompileShader(const std::string& shader_name,
                    const ShaderDesc& desc,
                    const std::string& output_path,
@@ -47,8 +76,395 @@ void CompileShader(const std::string& shader_name,
 {
     std::string path = output_path + "/" + shader_name + GetShaderExtension(shader_type);
     std::vector<uint8_t> blob = Compile(desc, shader_type);
-    std::fstream file(path, std::ios::out | std::ios::binary);
-    file.write(reinterpret_cast<char*>(blob.data()), blob.size());
+    WriteBlob(path, blob);
+}
+
+bool ParseCompileOption(const std::string& option, ShaderCompileOptions& options)
+{
+    static const std::map<std::string, ShaderOptimizationLevel> optimization_levels = {
+        { "-Od", ShaderOptimizationLevel::kDisabled }, { "-O0", ShaderOptimizationLevel::kLevel0 },
+        { "-O1", ShaderOptimizationLevel::kLevel1 },   { "-O2", ShaderOptimizationLevel::kLevel2 },
+        { "-O3", ShaderOptimizationLevel::kLevel3 },
+    };
+    static const std::map<std::string, SPIRVTargetEnv> spirv_target_envs = {
+        { "-fspv-target-env=vulkan1.1", SPIRVTargetEnv::kVulkan1_1 },
+        { "-fspv-target-env=vulkan1.2", SPIRVTargetEnv::kVulkan1_2 },
+        { "-fspv-target-env=vulkan1.3", SPIRVTargetEnv::kVulkan1_3 },
+    };
+    if (optimization_levels.count(option)) {
+        options.optimization_level = optimization_levels.at(option);
+    } else if (spirv_target_envs.count(option)) {
+        options.spirv_target_env = spirv_target_envs.at(option);
+    } else if (option == "-Qstrip_debug") {
+        options.strip_debug_info = true;
+    } else if (option == "-enable-16bit-types") {
+        options.enable_16bit_types = true;
+    } else if (option.rfind("-Fd", 0) == 0) {
+        options.pdb_path = option.substr(3);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+struct ManifestEntry {
+    std::string shader_name;
+    ShaderDesc desc;
+    uint64_t hash;
+};
+
+// Splits a line into whitespace separated tokens, "" quotes a token with spaces or an empty token
+std::vector<std::string> Tokenize(const std::string& line)
+{
+    std::vector<std::string> tokens;
+    size_t pos = 0;
+    while (true) {
+        pos = line.find_first_not_of(" \t\r", pos);
+        if (pos == std::string::npos || line[pos] == '#') {
+            break;
+        }
+        if (line[pos] == '"') {
+            size_t end = line.find('"', pos + 1);
+            if (end == std::string::npos) {
+                end = line.size();
+            }
+            tokens.emplace_back(line.substr(pos + 1, end - pos - 1));
+            pos = end + 1;
+        } else {
+            size_t end = line.find_first_of(" \t\r", pos);
+            if (end == std::string::npos) {
+                end = line.size();
+            }
+            tokens.emplace_back(line.substr(pos, end - pos));
+            pos = end;
+        }
+    }
+    return tokens;
+}
+
+// Each line is: shader_name path entrypoint type model [NAME=VALUE...] [-option...]
+// Options are -Od, -O0..-O3, -Qstrip_debug, -Fd<pdb path>, -enable-16bit-types and
+// -fspv-target-env=vulkan1.1..vulkan1.3.
+// Relative shader paths are resolved against the manifest directory.
+std::vector<ManifestEntry> ParseManifest(const std::string& manifest_path)
+{
+    std::vector<ManifestEntry> entries;
+    std::ifstream file(std::filesystem::u8path(manifest_path));
+    auto manifest_dir = std::filesystem::u8path(manifest_path).parent_path();
+    std::string line;
+    while (std::getline(file, line)) {
+        std::vector<std::string> tokens = Tokenize(line);
+        if (tokens.empty()) {
+            continue;
+        }
+        if (tokens.size() < 5) {
+            std::cout << "Invalid manifest entry: " << line << std::endl;
+            continue;
+        }
+
+        ManifestEntry& entry = entries.emplace_back();
+        entry.shader_name = tokens[0];
+        entry.desc.shader_path = (manifest_dir / std::filesystem::u8path(tokens[1])).lexically_normal().u8string();
+        entry.desc.entrypoint = tokens[2];
+        entry.desc.type = GetShaderType(tokens[3]);
+        entry.desc.model = tokens[4];
+        for (size_t i = 5; i < tokens.size(); ++i) {
+            if (tokens[i][0] == '-') {
+                if (!ParseCompileOption(tokens[i], entry.desc.options)) {
+                    std::cout << "Unknown compile option: " << tokens[i] << std::endl;
+                }
+                continue;
+            }
+            size_t separator = tokens[i].find('=');
+            if (separator == std::string::npos) {
+                entry.desc.define[tokens[i]] = "";
+            } else {
+                entry.desc.define[tokens[i].substr(0, separator)] = tokens[i].substr(separator + 1);
+            }
+        }
+
+        Hasher hasher;
+        hasher.Update(GetDxcCompilerStamp());
+        for (const auto& token : tokens) {
+            hasher.Update(token);
+        }
+        entry.hash = hasher.GetHash();
+    }
+    return entries;
+}
+
+// The stamp file stores, per shader name, the entry hash and the files read while compiling it
+class StampFile {
+public:
+    explicit StampFile(const std::string& path)
+        : m_path(path)
+    {
+        std::ifstream file(std::filesystem::u8path(m_path));
+        std::string line;
+        Stamp* stamp = nullptr;
+        while (std::getline(file, line)) {
+            if (line.empty()) {
+                continue;
+            }
+            if (line[0] == '\t') {
+                if (stamp) {
+                    stamp->dependencies.emplace_back(line.substr(1));
+                }
+                continue;
+            }
+            std::istringstream stream(line);
+            uint64_t hash = 0;
+            std::string shader_name;
+            stream >> std::hex >> hash;
+            stream.get();
+            std::getline(stream, shader_name);
+            stamp = &m_stamps[shader_name];
+            stamp->hash = hash;
+        }
+    }
+
+    bool IsUpToDate(const ManifestEntry& entry, const std::vector<std::string>& outputs) const
+    {
+        auto it = m_stamps.find(entry.shader_name);
+        if (it == m_stamps.end() || it->second.hash != entry.hash || it->second.dependencies.empty()) {
+            return false;
+        }
+
+        std::error_code ec;
+        std::filesystem::file_time_type oldest_output = std::filesystem::file_time_type::max();
+        for (const auto& output : outputs) {
+            auto time = std::filesystem::last_write_time(std::filesystem::u8path(output), ec);
+            if (ec) {
+                return false;
+            }
+            oldest_output = std::min(oldest_output, time);
+        }
+        for (const auto& dependency : it->second.dependencies) {
+            auto time = std::filesystem::last_write_time(std::filesystem::u8path(dependency), ec);
+            if (ec || time > oldest_output) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Update(const ManifestEntry& entry, const ShaderCacheDependencies& dependencies)
+    {
+        decltype(auto) stamp = m_stamps[entry.shader_name];
+        stamp.hash = entry.hash;
+        stamp.dependencies.clear();
+        for (const auto& [dependency, hash] : dependencies) {
+            // Include lookups that did not resolve to a file are not tracked
+            if (hash != 0) {
+                stamp.dependencies.emplace_back(dependency);
+            }
+        }
+    }
+
+    const std::vector<std::string>& GetDependencies(const ManifestEntry& entry) const
+    {
+        static const std::vector<std::string> empty;
+        auto it = m_stamps.find(entry.shader_name);
+        if (it == m_stamps.end()) {
+            return empty;
+        }
+        return it->second.dependencies;
+    }
+
+    void Save() const
+    {
+        std::string temp_path = m_path + ".tmp";
+        {
+            std::ofstream file(std::filesystem::u8path(temp_path), std::ios::trunc);
+            for (const auto& [shader_name, stamp] : m_stamps) {
+                file << std::hex << stamp.hash << " " << shader_name << "\n";
+                for (const auto& dependency : stamp.dependencies) {
+                    file << "\t" << dependency << "\n";
+                }
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(std::filesystem::u8path(temp_path), std::filesystem::u8path(m_path), ec);
+    }
+
+private:
+    struct Stamp {
+        uint64_t hash = 0;
+        std::vector<std::string> dependencies;
+    };
+
+    std::string m_path;
+    std::map<std::string, Stamp> m_stamps;
+};
+
+std::string EscapeDepfilePath(const std::string& path)
+{
+    std::string escaped;
+    for (char c : path) {
+        if (c == ' ' || c == '#') {
+            escaped += '\\';
+        } else if (c == '$') {
+            escaped += '$';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+// Makefile-style depfile for the build system: every output depends on all files read by any entry
+void WriteDepfile(const std::string& depfile_path,
+                  const std::vector<std::string>& outputs,
+                  const std::set<std::string>& dependencies)
+{
+    std::ofstream file(std::filesystem::u8path(depfile_path), std::ios::trunc);
+    for (const auto& output : outputs) {
+        file << EscapeDepfilePath(std::filesystem::u8path(output).lexically_normal().u8string()) << " ";
+    }
+    file << ":";
+    for (const auto& dependency : dependencies) {
+        file << " \\\n  " << EscapeDepfilePath(dependency);
+    }
+    file << "\n";
+}
+
+bool HasMSLOutput(const ManifestEntry& entry, bool emit_msl)
+{
+    return emit_msl && entry.desc.type != ShaderType::kLibrary;
+}
+
+int CompileManifest(const std::string& manifest_path,
+                    const std::string& output_dir,
+                    const std::string& depfile_path,
+                    bool emit_msl)
+{
+    const std::vector<ShaderBlobType> blob_types = { ShaderBlobType::kDXIL, ShaderBlobType::kSPIRV };
+    std::vector<ManifestEntry> entries = ParseManifest(manifest_path);
+    StampFile stamp_file(manifest_path + ".stamp");
+
+    std::vector<ManifestEntry> stale_entries;
+    std::vector<ShaderDesc> descs;
+    std::vector<std::string> all_outputs;
+    for (const auto& entry : entries) {
+        std::vector<std::string> outputs;
+        for (auto blob_type : blob_types) {
+            std::string blob_path = output_dir + "/" + entry.shader_name + GetShaderExtension(blob_type);
+            outputs.emplace_back(blob_path);
+            outputs.emplace_back(blob_path + kShaderReflectionExtension);
+        }
+        if (HasMSLOutput(entry, emit_msl)) {
+            outputs.emplace_back(output_dir + "/" + entry.shader_name + kMSLExtension);
+        }
+        all_outputs.insert(all_outputs.end(), outputs.begin(), outputs.end());
+        if (!stamp_file.IsUpToDate(entry, outputs)) {
+            stale_entries.emplace_back(entry);
+            descs.emplace_back(entry.desc);
+            continue;
+        }
+
+        // Build systems compare output timestamps against the manifest, which may have changed for other entries
+        std::error_code ec;
+        for (const auto& output : outputs) {
+            std::filesystem::last_write_time(std::filesystem::u8path(output),
+                                             std::filesystem::file_time_type::clock::now(), ec);
+        }
+    }
+
+    int exit_code = 0;
+    std::vector<std::vector<CompileResult>> results = CompileBatch(descs, blob_types);
+
+    // Outputs of different blobs are independent, so reflection and MSL conversion run in parallel as well
+    std::vector<std::string> msl_errors(stale_entries.size());
+    GetThreadPool().ParallelFor(stale_entries.size() * blob_types.size(), [&](size_t index) {
+        size_t i = index / blob_types.size();
+        size_t j = index % blob_types.size();
+        const CompileResult& result = results[i][j];
+        if (result.blob.empty()) {
+            return;
+        }
+        std::string blob_path = output_dir + "/" + stale_entries[i].shader_name + GetShaderExtension(blob_types[j]);
+        WriteBlob(blob_path, result.blob);
+        auto reflection = CreateShaderReflection(blob_types[j], result.blob.data(), result.blob.size());
+        WriteBlob(blob_path + kShaderReflectionExtension,
+                  SerializeShaderReflection(*reflection, result.blob.data(), result.blob.size()));
+
+        if (blob_types[j] != ShaderBlobType::kSPIRV || !HasMSLOutput(stale_entries[i], emit_msl)) {
+            return;
+        }
+        try {
+            std::map<std::string, uint32_t> mapping;
+            std::string source = GetMSLShader(result.blob.data(), result.blob.size(), mapping);
+            std::string record = SerializeMSLShader(source, mapping, result.blob.data(), result.blob.size());
+            WriteBlob(output_dir + "/" + stale_entries[i].shader_name + kMSLExtension,
+                      std::vector<uint8_t>(record.begin(), record.end()));
+        } catch (const std::exception& e) {
+            msl_errors[i] = e.what();
+        }
+    });
+
+    for (size_t i = 0; i < stale_entries.size(); ++i) {
+        bool succeeded = true;
+        // Blob types may read different files, e.g. includes guarded by backend defines
+        ShaderCacheDependencies dependencies;
+        for (size_t j = 0; j < blob_types.size(); ++j) {
+            const CompileResult& result = results[i][j];
+            dependencies.insert(result.dependencies.begin(), result.dependencies.end());
+            if (!result.diagnostics.empty()) {
+                std::cout << stale_entries[i].shader_name << GetShaderExtension(blob_types[j]) << ":\n"
+                          << result.diagnostics << std::endl;
+            }
+            if (result.blob.empty()) {
+                succeeded = false;
+            }
+        }
+        if (!msl_errors[i].empty()) {
+            std::cout << stale_entries[i].shader_name << kMSLExtension << ":\n" << msl_errors[i] << std::endl;
+            succeeded = false;
+        }
+        if (succeeded) {
+            stamp_file.Update(stale_entries[i], dependencies);
+        } else {
+            exit_code = 1;
+        }
+    }
+    stamp_file.Save();
+
+    // All blobs of the manifest are also packed into one archive that the runtime maps instead of reading each file
+    std::vector<ShaderArchiveItem> archive_items;
+    for (const auto& entry : entries) {
+        for (auto blob_type : blob_types) {
+            std::string blob_path = output_dir + "/" + entry.shader_name + GetShaderExtension(blob_type);
+            std::vector<uint8_t> blob = ReadBlob(blob_path);
+            if (blob.empty()) {
+                continue;
+            }
+            ShaderArchiveItem& item = archive_items.emplace_back();
+            item.name = entry.shader_name;
+            item.blob_type = blob_type;
+            item.blob = std::move(blob);
+            item.reflection = ReadBlob(blob_path + kShaderReflectionExtension);
+            if (blob_type == ShaderBlobType::kSPIRV && HasMSLOutput(entry, emit_msl)) {
+                item.msl = ReadBlob(output_dir + "/" + entry.shader_name + kMSLExtension);
+            }
+        }
+    }
+    std::string archive_path = output_dir + "/" + kShaderArchiveFileName;
+    if (!WriteShaderArchive(archive_path, archive_items)) {
+        std::cout << "Failed to write " << archive_path << std::endl;
+        exit_code = 1;
+    }
+    all_outputs.emplace_back(archive_path);
+
+    if (!depfile_path.empty()) {
+        std::set<std::string> dependencies = { manifest_path };
+        for (const auto& entry : entries) {
+            decltype(auto) entry_dependencies = stamp_file.GetDependencies(entry);
+            dependencies.insert(entry_dependencies.begin(), entry_dependencies.end());
+        }
+        WriteDepfile(depfile_path, all_outputs, dependencies);
+    }
+
+    std::cout << "Compiled " << stale_entries.size() << " of " << entries.size() << " shaders" << std::endl;
+    return exit_code;
 }
 
 } // namespace
@@ -94,6 +510,22 @@ private:
 
 int main(int argc, char* argv[])
 {
+    // --manifest <manifest> <output_dir> [depfile] [--msl], --msl also converts SPIR-V blobs to MSL
+    if (argc >= 2 && std::string(argv[1]) == "--manifest") {
+        std::vector<std::string> args;
+        bool emit_msl = false;
+        for (int i = 2; i < argc; ++i) {
+            if (std::string(argv[i]) == "--msl") {
+                emit_msl = true;
+            } else {
+                args.emplace_back(argv[i]);
+            }
+        }
+        if (args.size() == 2 || args.size() == 3) {
+            return CompileManifest(args[0], args[1], args.size() == 3 ? args[2] : "", emit_msl);
+        }
+    }
+
     ParseCmd cmd(argc, argv);
     CompileShader(cmd.GetShaderName(), cmd.GetShaderDesc(), cmd.GetOutputDir(), ShaderBlobType::kDXIL);
     CompileShader(cmd.GetShaderName(), cmd.GetShaderDesc(), cmd.GetOutputDir(), ShaderBlobType::kSPIRV);